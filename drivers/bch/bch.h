@@ -35,6 +35,7 @@
 
 #include <nuttx/mutex.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/bcache.h>
 
 /****************************************************************************
  * Pre-processor Definitions
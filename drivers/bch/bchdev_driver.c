@@ -448,6 +448,11 @@ static int bch_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
           /* Flush any dirty pages remaining in the cache */
 
           ret = bchlib_flushsector(bch, false);
+          if (ret >= 0)
+            {
+              ret = bcache_flush(bch->inode);
+            }
+
           if (ret < 0)
             {
               break;
@@ -127,7 +127,8 @@ int bchlib_flushsector(FAR struct bchlib_s *bch, bool discard)
 
       /* Write the sector to the media */
 
-      ret = inode->u.i_bops->write(inode, bch->buffer, bch->sector, 1);
+      ret = bcache_write(inode, bch->buffer, bch->sector, 1,
+                         bch->sectsize);
       if (ret < 0)
         {
           ferr("Write failed: %zd\n", ret);
@@ -196,7 +197,7 @@ int bchlib_readsector(FAR struct bchlib_s *bch, size_t sector)
           return (int)ret;
         }
 
-      ret = inode->u.i_bops->read(inode, bch->buffer, sector, 1);
+      ret = bcache_read(inode, bch->buffer, sector, 1, bch->sectsize);
       if (ret < 0)
         {
           ferr("Read failed: %zd\n", ret);
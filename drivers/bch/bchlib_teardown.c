@@ -65,6 +65,8 @@ int bchlib_teardown(FAR void *handle)
   /* Flush any pending data to the block driver */
 
   bchlib_flushsector(bch, false);
+  bcache_flush(bch->inode);
+  bcache_invalidate(bch->inode);
 
   /* Close the block driver */
 
@@ -39,6 +39,7 @@
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev_lowerhalf.h>
 #include <nuttx/net/pkt.h>
+#include <nuttx/net/tcp.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/spinlock.h>
 
@@ -62,6 +63,12 @@
 #  define NETDEV_THREAD_COUNT 1
 #endif
 
+#ifdef CONFIG_NETDEV_OFFLOAD
+#  define NETPKT_IS_GSO(pkt) (((pkt)->io_offload & NETPKT_GSO_MASK) != 0)
+#else
+#  define NETPKT_IS_GSO(pkt) false
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -87,6 +94,21 @@ struct netdev_upperhalf_s
 #if CONFIG_IOB_NCHAINS > 0
   struct iob_queue_s txq;
 #endif
+
+  /* RX packet held back for coalescing with the next ones */
+
+#ifdef CONFIG_NETDEV_GRO
+  FAR netpkt_t *gro;
+#endif
+
+  /* RX packets steered to the work thread of each CPU and the CPU of each
+   * flow (CPU ID + 1, zero if unknown), indexed by the flow hash.
+   */
+
+#ifdef CONFIG_NETDEV_RPS
+  struct iob_queue_s rxq[NETDEV_THREAD_COUNT];
+  uint8_t rps_flow[CONFIG_NETDEV_RPS_FLOWS];
+#endif
 };
 
 /****************************************************************************
@@ -248,6 +270,247 @@ static inline bool netdev_upper_can_tx(FAR struct netdev_upperhalf_s *upper)
   return quota > 0;
 }
 
+/****************************************************************************
+ * Name: netdev_upper_iplen
+ *
+ * Description:
+ *   Return the size of the IP header of a packet, or zero if it is neither
+ *   IPv4 nor IPv6.  IPv6 extension headers are not supported.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NETDEV_SOFT_GSO) || defined(CONFIG_NETDEV_GRO) || \
+    defined(CONFIG_NETDEV_RPS)
+static unsigned int netdev_upper_iplen(FAR netpkt_t *pkt)
+{
+  FAR uint8_t *ip = IOB_DATA(pkt);
+
+#ifdef CONFIG_NET_IPv4
+  if ((ip[0] & IP_VERSION_MASK) == IPv4_VERSION)
+    {
+      return (ip[0] & IPv4_HLMASK) << 2;
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+  if ((ip[0] & IP_VERSION_MASK) == IPv6_VERSION)
+    {
+      return IPv6_HDRLEN;
+    }
+#endif
+
+  return 0;
+}
+#endif
+
+/****************************************************************************
+ * Name: netdev_upper_gso_fixup
+ *
+ * Description:
+ *   Fix up the IP and TCP headers of a segment cut from a large packet.
+ *
+ * Input Parameters:
+ *   dev   - Reference to the NuttX driver state structure
+ *   seg   - The segment, with the headers of the large packet
+ *   iplen - The size of the IP header
+ *   off   - Offset of the payload of the segment in the large packet
+ *   index - Index of the segment
+ *   last  - True for the last segment
+ *
+ * Assumptions:
+ *   Called with the network locked and dev->d_iob detached.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_SOFT_GSO
+static void netdev_upper_gso_fixup(FAR struct net_driver_s *dev,
+                                   FAR netpkt_t *seg, unsigned int iplen,
+                                   uint16_t off, uint16_t index, bool last)
+{
+  FAR uint8_t *ip = IOB_DATA(seg);
+  FAR struct tcp_hdr_s *tcp = (FAR struct tcp_hdr_s *)(ip + iplen);
+  bool partial = NETDEV_HAS_FEATURE(dev, NETDEV_F_TXCSUM);
+  uint16_t len;
+
+  net_incr32(tcp->seqno, off);
+
+  /* FIN and PSH belong to the last segment only */
+
+  if (!last)
+    {
+      tcp->flags &= ~(TCP_FIN | TCP_PSH);
+    }
+
+  /* The checksum helpers work on d_iob */
+
+  dev->d_iob     = seg;
+  tcp->tcpchksum = 0;
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if ((ip[0] & IP_VERSION_MASK) == IPv6_VERSION)
+#endif
+    {
+      FAR struct ipv6_hdr_s *ipv6 = (FAR struct ipv6_hdr_s *)ip;
+
+      len          = seg->io_pktlen - IPv6_HDRLEN;
+      ipv6->len[0] = len >> 8;
+      ipv6->len[1] = len & 0xff;
+
+      tcp->tcpchksum = partial ?
+        HTONS(ipv6_upperlayer_header_chksum(dev, IP_PROTO_TCP, iplen)) :
+        ~ipv6_upperlayer_chksum(dev, IP_PROTO_TCP, iplen);
+    }
+#endif /* CONFIG_NET_IPv6 */
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      FAR struct ipv4_hdr_s *ipv4 = (FAR struct ipv4_hdr_s *)ip;
+
+      len             = seg->io_pktlen;
+      ipv4->len[0]    = len >> 8;
+      ipv4->len[1]    = len & 0xff;
+
+      len             = ((uint16_t)ipv4->ipid[0] << 8) + ipv4->ipid[1];
+      len            += index;
+      ipv4->ipid[0]   = len >> 8;
+      ipv4->ipid[1]   = len & 0xff;
+
+      ipv4->ipchksum  = 0;
+      ipv4->ipchksum  = ~ipv4_chksum(ipv4);
+
+      tcp->tcpchksum = partial ?
+        HTONS(ipv4_upperlayer_header_chksum(dev, IP_PROTO_TCP)) :
+        ~ipv4_upperlayer_chksum(dev, IP_PROTO_TCP);
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+  dev->d_iob = NULL;
+
+  if (partial)
+    {
+      seg->io_offload   = NETPKT_CSUM_PARTIAL;
+      seg->io_csumstart = iplen;
+      seg->io_csumoff   = offsetof(struct tcp_hdr_s, tcpchksum);
+    }
+}
+
+/****************************************************************************
+ * Name: netdev_upper_gso
+ *
+ * Description:
+ *   Cut the large TCP packet in d_iob into segments of io_gsosize bytes of
+ *   payload and queue them for transmission.  This is done for lower
+ *   halves without TCP segmentation offload, the network stack still runs
+ *   only once for all of the segments.
+ *
+ * Input Parameters:
+ *   dev - Reference to the NuttX driver state structure
+ *
+ * Returned Value:
+ *   Negated errno value - Error number that occurs.
+ *   NETDEV_TX_CONTINUE  - The segments are queued, continue the poll.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static int netdev_upper_gso(FAR struct net_driver_s *dev)
+{
+  FAR struct netdev_upperhalf_s *upper = dev->d_private;
+  FAR netpkt_t *pkt = dev->d_iob;
+  FAR netpkt_t *seg;
+  FAR uint8_t *ip = IOB_DATA(pkt);
+  unsigned int llhdrlen = NET_LL_HDRLEN(dev);
+  unsigned int iplen;
+  unsigned int hdrlen;
+  unsigned int paylen;
+  unsigned int seglen;
+  unsigned int off;
+  uint16_t index = 0;
+  int ret = -EINVAL;
+
+  iplen = netdev_upper_iplen(pkt);
+  if (iplen == 0 || pkt->io_len < iplen + TCP_HDRLEN)
+    {
+      goto errout;
+    }
+
+  hdrlen = iplen + ((((FAR struct tcp_hdr_s *)(ip + iplen))->tcpoffset
+                     >> 4) << 2);
+  if (pkt->io_len < hdrlen || pkt->io_gsosize == 0)
+    {
+      goto errout;
+    }
+
+  paylen = pkt->io_pktlen - hdrlen;
+  netdev_iob_clear(dev);
+
+  for (off = 0; off < paylen; off += seglen, index++)
+    {
+      seglen = MIN(pkt->io_gsosize, paylen - off);
+
+      seg = iob_tryalloc(false);
+      if (seg == NULL)
+        {
+          ret = -ENOMEM;
+          break;
+        }
+
+      /* Copy the link layer header, the IP and TCP headers and then the
+       * payload of the segment.
+       */
+
+      iob_reserve(seg, CONFIG_NET_LL_GUARDSIZE);
+      memcpy(IOB_DATA(seg) - llhdrlen, ip - llhdrlen, llhdrlen);
+
+      if (iob_trycopyin(seg, ip, hdrlen, 0, false) != hdrlen ||
+          seg->io_len < hdrlen ||
+          iob_clone_partial(pkt, seglen, hdrlen + off, seg, hdrlen,
+                            false, false) < 0)
+        {
+          iob_free_chain(seg);
+          ret = -ENOMEM;
+          break;
+        }
+
+      netdev_upper_gso_fixup(dev, seg, iplen, off, index,
+                             off + seglen == paylen);
+
+      ret = iob_tryadd_queue(seg, &upper->txq);
+      if (ret < 0)
+        {
+          iob_free_chain(seg);
+          break;
+        }
+    }
+
+  iob_free_chain(pkt);
+
+  /* The queued segments are sent first by netdev_upper_tx(), a partly
+   * sent packet is retransmitted by TCP.
+   */
+
+  if (index > 0)
+    {
+      return NETDEV_TX_CONTINUE;
+    }
+
+  NETDEV_TXERRORS(dev);
+  return ret;
+
+errout:
+  nerr("ERROR: Bad segmentation offload packet\n");
+  NETDEV_TXERRORS(dev);
+  netdev_iob_release(dev);
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Name: netdev_upper_txpoll
  *
@@ -282,6 +545,13 @@ static int netdev_upper_txpoll(FAR struct net_driver_s *dev)
 
   DEBUGASSERT(dev->d_len > 0);
 
+#ifdef CONFIG_NETDEV_SOFT_GSO
+  if (NETPKT_IS_GSO(dev->d_iob) && !NETDEV_HAS_FEATURE(dev, NETDEV_F_TSO))
+    {
+      return netdev_upper_gso(dev);
+    }
+#endif
+
   NETDEV_TXPACKETS(dev);
 
 #ifdef CONFIG_NET_PKT
@@ -292,7 +562,8 @@ static int netdev_upper_txpoll(FAR struct net_driver_s *dev)
 
   pkt = netpkt_get(dev, NETPKT_TX);
 
-  if (netpkt_getdatalen(lower, pkt) > NETDEV_PKTSIZE(dev))
+  if (netpkt_getdatalen(lower, pkt) > NETDEV_PKTSIZE(dev) &&
+      !NETPKT_IS_GSO(pkt))
     {
       nerr("ERROR: Packet too long to send!\n");
       ret = -EMSGSIZE;
@@ -583,6 +854,547 @@ static void ip_input(FAR struct net_driver_s *dev)
 }
 #endif
 
+/****************************************************************************
+ * Name: netdev_upper_input
+ *
+ * Description:
+ *   Pass a received packet into the network stack.
+ *
+ * Input Parameters:
+ *   upper - Reference to the upper half driver structure
+ *   pkt   - The received packet
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static void netdev_upper_input(FAR struct netdev_upperhalf_s *upper,
+                               FAR netpkt_t *pkt)
+{
+  FAR struct net_driver_s *dev = &upper->lower->netdev;
+
+  netpkt_put(dev, pkt, NETPKT_RX);
+  NETDEV_RXPACKETS(dev);
+
+#ifdef CONFIG_NET_PKT
+  /* When packet sockets are enabled, feed the frame into the tap */
+
+  pkt_input(dev);
+#endif
+
+  switch (dev->d_lltype)
+    {
+#ifdef CONFIG_NET_LOOPBACK
+    case NET_LL_LOOPBACK:
+#endif
+#ifdef CONFIG_NET_ETHERNET
+    case NET_LL_ETHERNET:
+#endif
+#ifdef CONFIG_DRIVERS_IEEE80211
+    case NET_LL_IEEE80211:
+#endif
+#if defined(CONFIG_NET_LOOPBACK) || defined(CONFIG_NET_ETHERNET) || \
+    defined(CONFIG_DRIVERS_IEEE80211)
+      eth_input(dev);
+      break;
+#endif
+#ifdef CONFIG_NET_MBIM
+    case NET_LL_MBIM:
+      ip_input(dev);
+      break;
+#endif
+#ifdef CONFIG_NET_CAN
+    case NET_LL_CAN:
+      ninfo("CAN frame");
+      can_input(dev);
+      break;
+#endif
+    default:
+      nerr("Unknown link type %d\n", dev->d_lltype);
+      break;
+    }
+}
+
+/****************************************************************************
+ * Name: netdev_upper_wakeup
+ *
+ * Description:
+ *   Wake up the work thread of a CPU if it is not already signaled.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_WORK_THREAD
+static void netdev_upper_wakeup(FAR struct netdev_upperhalf_s *upper,
+                                int cpu)
+{
+  int semcount;
+
+  if (nxsem_get_value(&upper->sem[cpu], &semcount) == OK &&
+      semcount <= 0)
+    {
+      nxsem_post(&upper->sem[cpu]);
+    }
+}
+#endif
+
+#ifdef CONFIG_NETDEV_RPS
+/****************************************************************************
+ * Name: netdev_upper_rps_cpu
+ *
+ * Description:
+ *   Look up the CPU of the flow of a received TCP or UDP packet, as learned
+ *   from the SIOCNOTIFYRECVCPU notifications.
+ *
+ * Input Parameters:
+ *   upper - Reference to the upper half driver structure
+ *   pkt   - The received packet
+ *
+ * Returned Value:
+ *   The CPU ID, or a negative value if the flow is unknown.
+ *
+ ****************************************************************************/
+
+static int netdev_upper_rps_cpu(FAR struct netdev_upperhalf_s *upper,
+                                FAR netpkt_t *pkt)
+{
+  FAR struct net_driver_s *dev = &upper->lower->netdev;
+  FAR uint8_t *ip = IOB_DATA(pkt);
+  FAR struct eth_hdr_s *eth;
+  net_ipv6addr_t srcaddr;
+  net_ipv6addr_t destaddr;
+  unsigned int iplen;
+  uint16_t ports[2];
+  uint32_t hash;
+  uint8_t domain;
+  uint8_t proto;
+
+  if (dev->d_lltype != NET_LL_ETHERNET)
+    {
+      return -1;
+    }
+
+  eth   = (FAR struct eth_hdr_s *)(ip - ETH_HDRLEN);
+  iplen = netdev_upper_iplen(pkt);
+  if (iplen == 0 || pkt->io_len < iplen + sizeof(ports))
+    {
+      return -1;
+    }
+
+#ifdef CONFIG_NET_IPv4
+  if (eth->type == HTONS(ETHTYPE_IP))
+    {
+      FAR struct ipv4_hdr_s *ipv4 = (FAR struct ipv4_hdr_s *)ip;
+
+      /* Fragments are left to the receiving CPU, the ports are only in the
+       * first one.
+       */
+
+      if ((((ipv4->ipoffset[0] << 8) | ipv4->ipoffset[1]) &
+           ~IP_FLAG_DONTFRAG) != 0)
+        {
+          return -1;
+        }
+
+      domain = PF_INET;
+      proto  = ipv4->proto;
+      memcpy(srcaddr, ipv4->srcipaddr, sizeof(in_addr_t));
+      memcpy(destaddr, ipv4->destipaddr, sizeof(in_addr_t));
+    }
+  else
+#endif
+#ifdef CONFIG_NET_IPv6
+  if (eth->type == HTONS(ETHTYPE_IP6))
+    {
+      FAR struct ipv6_hdr_s *ipv6 = (FAR struct ipv6_hdr_s *)ip;
+
+      domain = PF_INET6;
+      proto  = ipv6->proto;
+      net_ipv6addr_copy(srcaddr, ipv6->srcipaddr);
+      net_ipv6addr_copy(destaddr, ipv6->destipaddr);
+    }
+  else
+#endif
+    {
+      return -1;
+    }
+
+  if (proto != IP_PROTO_TCP && proto != IP_PROTO_UDP)
+    {
+      return -1;
+    }
+
+  /* The source and destination ports start both TCP and UDP headers.  The
+   * flow is hashed from the local side, as the socket layer does.
+   */
+
+  memcpy(ports, ip + iplen, sizeof(ports));
+  hash = netdev_rss_hash(domain, destaddr, ports[1], srcaddr, ports[0]);
+
+  return upper->rps_flow[hash % CONFIG_NETDEV_RPS_FLOWS] - 1;
+}
+
+/****************************************************************************
+ * Name: netdev_upper_rps_input
+ *
+ * Description:
+ *   Pass a received packet into the network stack on the CPU of its flow.
+ *   The packets of unknown flows and of the flows of this CPU are
+ *   processed right away, the others are queued to the work thread of
+ *   their CPU.  A flow keeps its order as long as its CPU does not change.
+ *
+ * Input Parameters:
+ *   upper - Reference to the upper half driver structure
+ *   pkt   - The received packet
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static void netdev_upper_rps_input(FAR struct netdev_upperhalf_s *upper,
+                                   FAR netpkt_t *pkt)
+{
+  int cpu = netdev_upper_rps_cpu(upper, pkt);
+
+  if (cpu >= 0 && cpu != this_cpu() &&
+      iob_tryadd_queue(pkt, &upper->rxq[cpu]) >= 0)
+    {
+      netdev_upper_wakeup(upper, cpu);
+      return;
+    }
+
+  netdev_upper_input(upper, pkt);
+}
+
+/****************************************************************************
+ * Name: netdev_upper_rps_work
+ *
+ * Description:
+ *   Pass the packets steered to a CPU into the network stack.
+ *
+ * Input Parameters:
+ *   upper - Reference to the upper half driver structure
+ *   cpu   - The CPU of the calling work thread
+ *
+ ****************************************************************************/
+
+static void netdev_upper_rps_work(FAR struct netdev_upperhalf_s *upper,
+                                  int cpu)
+{
+  FAR struct netdev_lowerhalf_s *lower = upper->lower;
+  FAR netpkt_t *pkt;
+
+  net_lock();
+
+  while ((pkt = iob_remove_queue(&upper->rxq[cpu])) != NULL)
+    {
+      if (!IFF_IS_UP(lower->netdev.d_flags))
+        {
+          NETDEV_RXDROPPED(&lower->netdev);
+          netpkt_free(lower, pkt, NETPKT_RX);
+          continue;
+        }
+
+      netdev_upper_input(upper, pkt);
+    }
+
+  net_unlock();
+}
+#else
+#  define netdev_upper_rps_input(upper, pkt) netdev_upper_input(upper, pkt)
+#endif /* CONFIG_NETDEV_RPS */
+
+#ifdef CONFIG_NETDEV_GRO
+/****************************************************************************
+ * Name: netdev_upper_gro_tcp
+ *
+ * Description:
+ *   Check if a received packet may be coalesced: a TCP segment in an
+ *   Ethernet frame with a payload, no flags but ACK and PSH and a checksum
+ *   verified by the lower half.
+ *
+ * Input Parameters:
+ *   dev    - Reference to the NuttX driver state structure
+ *   pkt    - The received packet
+ *   hdrlen - Location to return the size of the IP and TCP headers
+ *
+ * Returned Value:
+ *   The TCP header of the packet, or NULL if it can not be coalesced.
+ *
+ ****************************************************************************/
+
+static FAR struct tcp_hdr_s *
+netdev_upper_gro_tcp(FAR struct net_driver_s *dev, FAR netpkt_t *pkt,
+                     FAR unsigned int *hdrlen)
+{
+  FAR struct eth_hdr_s *eth;
+  FAR struct tcp_hdr_s *tcp;
+  FAR uint8_t *ip = IOB_DATA(pkt);
+  unsigned int iplen;
+  unsigned int len;
+
+  if (dev->d_lltype != NET_LL_ETHERNET ||
+      (pkt->io_offload & NETPKT_CSUM_VALID) == 0)
+    {
+      return NULL;
+    }
+
+  eth   = (FAR struct eth_hdr_s *)(ip - ETH_HDRLEN);
+  iplen = netdev_upper_iplen(pkt);
+  if (iplen == 0 || pkt->io_len < iplen + TCP_HDRLEN)
+    {
+      return NULL;
+    }
+
+  /* The IP length must match the frame, which is not the case for padded
+   * short frames.
+   */
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (iplen == IPv6_HDRLEN)
+#endif
+    {
+      FAR struct ipv6_hdr_s *ipv6 = (FAR struct ipv6_hdr_s *)ip;
+
+      len = ((uint16_t)ipv6->len[0] << 8) + ipv6->len[1] + IPv6_HDRLEN;
+      if (eth->type != HTONS(ETHTYPE_IP6) || ipv6->proto != IP_PROTO_TCP)
+        {
+          return NULL;
+        }
+    }
+#endif /* CONFIG_NET_IPv6 */
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      FAR struct ipv4_hdr_s *ipv4 = (FAR struct ipv4_hdr_s *)ip;
+
+      /* No IP options and no fragments */
+
+      len = ((uint16_t)ipv4->len[0] << 8) + ipv4->len[1];
+      if (eth->type != HTONS(ETHTYPE_IP) || iplen != IPv4_HDRLEN ||
+          ipv4->proto != IP_PROTO_TCP ||
+          (((ipv4->ipoffset[0] << 8) | ipv4->ipoffset[1]) &
+           ~IP_FLAG_DONTFRAG) != 0)
+        {
+          return NULL;
+        }
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+  tcp     = (FAR struct tcp_hdr_s *)(ip + iplen);
+  *hdrlen = iplen + ((tcp->tcpoffset >> 4) << 2);
+
+  if (len != pkt->io_pktlen || pkt->io_len < *hdrlen ||
+      len <= *hdrlen || (tcp->flags & TCP_CTL & ~TCP_PSH) != TCP_ACK)
+    {
+      return NULL;
+    }
+
+  return tcp;
+}
+
+/****************************************************************************
+ * Name: netdev_upper_gro_flush
+ *
+ * Description:
+ *   Pass the packet held back for coalescing into the network stack.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static void netdev_upper_gro_flush(FAR struct netdev_upperhalf_s *upper)
+{
+  FAR netpkt_t *pkt = upper->gro;
+
+  if (pkt != NULL)
+    {
+      upper->gro = NULL;
+      netdev_upper_rps_input(upper, pkt);
+    }
+}
+
+/****************************************************************************
+ * Name: netdev_upper_gro_merge
+ *
+ * Description:
+ *   Append the payload of 'pkt' to the held packet if it is the next
+ *   segment of the same flow.
+ *
+ * Returned Value:
+ *   True if the packet was merged and released.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static bool netdev_upper_gro_merge(FAR struct netdev_upperhalf_s *upper,
+                                   FAR netpkt_t *pkt,
+                                   FAR struct tcp_hdr_s *tcp,
+                                   unsigned int hdrlen)
+{
+  FAR netpkt_t *held = upper->gro;
+  FAR uint8_t *hip = IOB_DATA(held);
+  FAR uint8_t *ip = IOB_DATA(pkt);
+  FAR struct tcp_hdr_s *htcp;
+  unsigned int iplen = (FAR uint8_t *)tcp - ip;
+  unsigned int addrlen;
+  unsigned int len;
+  uint8_t seqno[4];
+
+  htcp    = (FAR struct tcp_hdr_s *)(hip + iplen);
+  len     = held->io_pktlen + pkt->io_pktlen - hdrlen;
+  addrlen = iplen > 20 ? 2 * sizeof(net_ipv6addr_t) : 2 * sizeof(in_addr_t);
+
+  /* The IP addresses are at the end of both IP headers.  Both packets must
+   * be of the same flow and carry the same ACK, window and options.
+   */
+
+  if (netdev_upper_iplen(held) != iplen ||
+      htcp->tcpoffset != tcp->tcpoffset ||
+      len > CONFIG_NETDEV_GRO_MAXSIZE ||
+      memcmp(hip + iplen - addrlen, ip + iplen - addrlen, addrlen) != 0 ||
+      memcmp(htcp, tcp, offsetof(struct tcp_hdr_s, seqno)) != 0 ||
+      memcmp(htcp->ackno, tcp->ackno, sizeof(tcp->ackno)) != 0 ||
+      memcmp(htcp->wnd, tcp->wnd, sizeof(tcp->wnd)) != 0 ||
+      memcmp(htcp->optdata, tcp->optdata, hdrlen - iplen - TCP_HDRLEN) != 0)
+    {
+      return false;
+    }
+
+  /* The sequence number must continue the held packet */
+
+  memcpy(seqno, htcp->seqno, sizeof(seqno));
+  net_incr32(seqno, held->io_pktlen - hdrlen);
+  if (memcmp(seqno, tcp->seqno, sizeof(seqno)) != 0)
+    {
+      return false;
+    }
+
+  htcp->flags |= tcp->flags;
+
+  /* Drop the headers of the packet and chain its payload to the held one.
+   * The TCP checksum of the result is not valid, but it is not checked.
+   */
+
+  iob_concat(held, iob_trimhead(pkt, hdrlen));
+  atomic_fetch_add(&upper->lower->quota[NETPKT_RX], 1);
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (iplen == IPv6_HDRLEN)
+#endif
+    {
+      FAR struct ipv6_hdr_s *ipv6 = (FAR struct ipv6_hdr_s *)hip;
+
+      ipv6->len[0] = (len - IPv6_HDRLEN) >> 8;
+      ipv6->len[1] = (len - IPv6_HDRLEN) & 0xff;
+    }
+#endif /* CONFIG_NET_IPv6 */
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      FAR struct ipv4_hdr_s *ipv4 = (FAR struct ipv4_hdr_s *)hip;
+
+      ipv4->len[0]   = len >> 8;
+      ipv4->len[1]   = len & 0xff;
+      ipv4->ipchksum = 0;
+      ipv4->ipchksum = ~ipv4_chksum(ipv4);
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: netdev_upper_gro
+ *
+ * Description:
+ *   Coalesce consecutive TCP segments of one flow.  A segment that may be
+ *   coalesced is held back until the next packet shows whether it
+ *   continues the same flow.  PSH, a short segment or the size limit end
+ *   the coalescing.
+ *
+ * Input Parameters:
+ *   upper - Reference to the upper half driver structure
+ *   pkt   - The received packet
+ *
+ * Returned Value:
+ *   The packet to pass into the network stack now, or NULL if the packet
+ *   was merged or held back.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static FAR netpkt_t *netdev_upper_gro(FAR struct netdev_upperhalf_s *upper,
+                                      FAR netpkt_t *pkt)
+{
+  FAR struct net_driver_s *dev = &upper->lower->netdev;
+  FAR struct tcp_hdr_s *tcp;
+  unsigned int hdrlen;
+  unsigned int paylen;
+
+  tcp = netdev_upper_gro_tcp(dev, pkt, &hdrlen);
+  if (tcp == NULL)
+    {
+      /* Keep the order of the packets */
+
+      netdev_upper_gro_flush(upper);
+      return pkt;
+    }
+
+  paylen = pkt->io_pktlen - hdrlen;
+
+  if (upper->gro != NULL)
+    {
+      FAR netpkt_t *held = upper->gro;
+
+      if (paylen <= held->io_gsosize &&
+          netdev_upper_gro_merge(upper, pkt, tcp, hdrlen))
+        {
+          tcp = (FAR struct tcp_hdr_s *)
+                (IOB_DATA(held) + netdev_upper_iplen(held));
+
+          if ((tcp->flags & TCP_PSH) != 0 || paylen < held->io_gsosize ||
+              held->io_pktlen + held->io_gsosize >
+              CONFIG_NETDEV_GRO_MAXSIZE)
+            {
+              netdev_upper_gro_flush(upper);
+            }
+
+          return NULL;
+        }
+
+      netdev_upper_gro_flush(upper);
+    }
+
+  if ((tcp->flags & TCP_PSH) != 0)
+    {
+      return pkt;
+    }
+
+  /* Hold the segment back, remember its size as the size of the segments
+   * that may follow.
+   */
+
+  pkt->io_gsosize = paylen;
+  upper->gro      = pkt;
+  return NULL;
+}
+#endif /* CONFIG_NETDEV_GRO */
+
 /****************************************************************************
  * Function: netdev_upper_rxpoll_work
  *
@@ -617,47 +1429,20 @@ static void netdev_upper_rxpoll_work(FAR struct netdev_upperhalf_s *upper)
           continue;
         }
 
-      netpkt_put(dev, pkt, NETPKT_RX);
-      NETDEV_RXPACKETS(dev);
-
-#ifdef CONFIG_NET_PKT
-      /* When packet sockets are enabled, feed the frame into the tap */
-
-      pkt_input(dev);
-#endif
-
-      switch (dev->d_lltype)
+#ifdef CONFIG_NETDEV_GRO
+      pkt = netdev_upper_gro(upper, pkt);
+      if (pkt == NULL)
         {
-#ifdef CONFIG_NET_LOOPBACK
-        case NET_LL_LOOPBACK:
-#endif
-#ifdef CONFIG_NET_ETHERNET
-        case NET_LL_ETHERNET:
-#endif
-#ifdef CONFIG_DRIVERS_IEEE80211
-        case NET_LL_IEEE80211:
-#endif
-#if defined(CONFIG_NET_LOOPBACK) || defined(CONFIG_NET_ETHERNET) || \
-    defined(CONFIG_DRIVERS_IEEE80211)
-          eth_input(dev);
-          break;
-#endif
-#ifdef CONFIG_NET_MBIM
-        case NET_LL_MBIM:
-          ip_input(dev);
-          break;
-#endif
-#ifdef CONFIG_NET_CAN
-        case NET_LL_CAN:
-          ninfo("CAN frame");
-          can_input(dev);
-          break;
-#endif
-        default:
-          nerr("Unknown link type %d\n", dev->d_lltype);
-          break;
+          continue;
         }
+#endif
+
+      netdev_upper_rps_input(upper, pkt);
     }
+
+#ifdef CONFIG_NETDEV_GRO
+  netdev_upper_gro_flush(upper);
+#endif
 }
 
 /****************************************************************************
@@ -729,6 +1514,9 @@ static int netdev_upper_loop(int argc, FAR char *argv[])
   while (netdev_upper_wait(&upper->sem[cpu]) == OK &&
          upper->tid[cpu] != INVALID_PROCESS_ID)
     {
+#ifdef CONFIG_NETDEV_RPS
+      netdev_upper_rps_work(upper, cpu);
+#endif
       netdev_upper_work(upper);
     }
 
@@ -759,13 +1547,8 @@ static inline void netdev_upper_queue_work(FAR struct net_driver_s *dev)
 #  else
   const int cpu = 0;
 #  endif
-  int semcount;
 
-  if (nxsem_get_value(&upper->sem[cpu], &semcount) == OK &&
-      semcount <= 0)
-    {
-      nxsem_post(&upper->sem[cpu]);
-    }
+  netdev_upper_wakeup(upper, cpu);
 #else
   if (work_available(&upper->work))
     {
@@ -1156,6 +1939,30 @@ static int netdev_upper_ioctl(FAR struct net_driver_s *dev, int cmd,
     }
 #endif
 
+#ifdef CONFIG_NETDEV_RPS
+  /* Learn the CPU of the flow, then let the lower half steer it in
+   * hardware too if it can.
+   */
+
+  if (cmd == SIOCNOTIFYRECVCPU)
+    {
+      FAR struct netdev_rss_s *rss = (FAR struct netdev_rss_s *)arg;
+
+      if (rss->cpu >= 0 && rss->cpu < NETDEV_THREAD_COUNT)
+        {
+          upper->rps_flow[rss->hash % CONFIG_NETDEV_RPS_FLOWS] =
+            rss->cpu + 1;
+        }
+
+      if (lower->ops->ioctl)
+        {
+          lower->ops->ioctl(lower, cmd, arg);
+        }
+
+      return OK;
+    }
+#endif
+
   if (lower->ops->ioctl)
     {
       return lower->ops->ioctl(lower, cmd, arg);
@@ -1218,6 +2025,20 @@ int netdev_lower_register(FAR struct netdev_lowerhalf_s *dev,
 #endif
   dev->netdev.d_private = upper;
 
+#ifdef CONFIG_NETDEV_OFFLOAD
+  /* Large TCP packets are accepted if either the lower half or the upper
+   * half can cut them into segments.
+   */
+
+  dev->netdev.d_features &= ~NETDEV_F_GSO;
+#  ifndef CONFIG_NETDEV_SOFT_GSO
+  if (NETDEV_HAS_FEATURE(&dev->netdev, NETDEV_F_TSO))
+#  endif
+    {
+      dev->netdev.d_features |= NETDEV_F_GSO;
+    }
+#endif
+
   ret = netdev_register(&dev->netdev, lltype);
   if (ret < 0)
     {
@@ -1285,6 +2106,9 @@ int netdev_lower_unregister(FAR struct netdev_lowerhalf_s *dev)
 
       nxsem_destroy(&upper->sem[i]);
       nxsem_destroy(&upper->sem_exit[i]);
+#ifdef CONFIG_NETDEV_RPS
+      iob_free_queue(&upper->rxq[i]);
+#endif
     }
 #endif
 
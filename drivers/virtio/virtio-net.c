@@ -44,7 +44,20 @@
 
 /* Virtio net feature bits */
 
-#define VIRTIO_NET_F_MAC      5
+#define VIRTIO_NET_F_CSUM       0
+#define VIRTIO_NET_F_GUEST_CSUM 1
+#define VIRTIO_NET_F_MAC        5
+#define VIRTIO_NET_F_HOST_TSO4  11
+#define VIRTIO_NET_F_HOST_TSO6  12
+
+/* Virtio net header flags and gso types */
+
+#define VIRTIO_NET_HDR_F_NEEDS_CSUM   1
+#define VIRTIO_NET_HDR_F_DATA_VALID   2
+
+#define VIRTIO_NET_HDR_GSO_NONE       0
+#define VIRTIO_NET_HDR_GSO_TCPV4      1
+#define VIRTIO_NET_HDR_GSO_TCPV6      4
 
 /* Virtio net header size and packet buffer size */
 
@@ -63,12 +76,25 @@
 #define VIRTIO_NET_MAX_NIOB \
     ((VIRTIO_NET_MAX_PKT_SIZE + CONFIG_IOB_BUFSIZE - 1) / CONFIG_IOB_BUFSIZE)
 
+/* TX packets may be TSO super-frames when the offload is negotiated */
+
+#ifdef CONFIG_NETDEV_OFFLOAD
+#  define VIRTIO_NET_TX_BUFSIZE \
+    (ETH_HDRLEN + CONFIG_NETDEV_GSO_MAXSIZE + CONFIG_NET_GUARDSIZE)
+#  define VIRTIO_NET_TX_MAX_NIOB \
+    (((CONFIG_NET_LL_GUARDSIZE - ETH_HDRLEN) + VIRTIO_NET_TX_BUFSIZE + \
+      CONFIG_IOB_BUFSIZE - 1) / CONFIG_IOB_BUFSIZE)
+#else
+#  define VIRTIO_NET_TX_BUFSIZE  VIRTIO_NET_BUFSIZE
+#  define VIRTIO_NET_TX_MAX_NIOB VIRTIO_NET_MAX_NIOB
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
-/* Virtio net header, just define it here for further, now only use it
- * to calculate the virto net header size, see marco VIRTIO_NET_HDRSIZE
+/* Virtio net header, carries the checksum and segmentation offload
+ * metadata of each packet, see marco VIRTIO_NET_HDRSIZE for its size.
  */
 
 begin_packed_struct struct virtio_net_hdr_s
@@ -118,6 +144,7 @@ struct virtio_net_priv_s
 
   FAR struct virtio_device *vdev;      /* Virtio device pointer */
   int                       bufnum;    /* TX and RX Buffer number */
+  int                       txbufnum;  /* TX Buffer number */
 };
 
 /* Virtio Link Layer Header, follow shows the iob buffer layout:
@@ -205,6 +232,114 @@ static uint8_t g_netdev_num = 0;
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_NETDEV_OFFLOAD
+/****************************************************************************
+ * Name: virtio_net_has_tso
+ *
+ * Description:
+ *   TSO needs the device to complete the checksum and to handle both IP
+ *   versions, and a TX ring that can hold at least one super-frame.
+ *
+ ****************************************************************************/
+
+static bool virtio_net_has_tso(FAR struct virtio_device *vdev)
+{
+  return virtio_has_feature(vdev, VIRTIO_NET_F_CSUM) &&
+         virtio_has_feature(vdev, VIRTIO_NET_F_HOST_TSO4) &&
+         virtio_has_feature(vdev, VIRTIO_NET_F_HOST_TSO6) &&
+         vdev->vrings_info[VIRTIO_NET_TX].info.num_descs >
+         VIRTIO_NET_TX_MAX_NIOB;
+}
+
+/****************************************************************************
+ * Name: virtio_net_txoffload
+ *
+ * Description:
+ *   Translate the offload metadata of an outgoing packet into the virtio
+ *   net header.  The TCP checksum field already holds the pseudo header
+ *   sum, the device completes it from csum_start and, for GSO packets,
+ *   splits the payload into gso_size segments.
+ *
+ ****************************************************************************/
+
+static void virtio_net_txoffload(FAR struct netdev_lowerhalf_s *dev,
+                                 FAR netpkt_t *pkt,
+                                 FAR struct virtio_net_hdr_s *vhdr)
+{
+  FAR uint8_t *l4;
+
+  if ((pkt->io_offload & NETPKT_CSUM_PARTIAL) == 0)
+    {
+      return;
+    }
+
+  vhdr->flags       = VIRTIO_NET_HDR_F_NEEDS_CSUM;
+  vhdr->csum_start  = ETH_HDRLEN + pkt->io_csumstart;
+  vhdr->csum_offset = pkt->io_csumoff;
+
+  if ((pkt->io_offload & NETPKT_GSO_MASK) != 0)
+    {
+      /* The headers are built contiguously in the first buffer, the
+       * upper nibble of byte 12 is the TCP data offset in words.
+       */
+
+      l4 = netpkt_getdata(dev, pkt) + vhdr->csum_start;
+
+      vhdr->gso_type = (pkt->io_offload & NETPKT_GSO_TCPV6) != 0 ?
+                       VIRTIO_NET_HDR_GSO_TCPV6 : VIRTIO_NET_HDR_GSO_TCPV4;
+      vhdr->gso_size = pkt->io_gsosize;
+      vhdr->hdr_len  = vhdr->csum_start + ((l4[12] >> 4) << 2);
+    }
+}
+
+/****************************************************************************
+ * Name: virtio_net_rxoffload
+ *
+ * Description:
+ *   Apply the virtio net header of a received packet.  A packet that the
+ *   other side left with a partial checksum is completed here, so the
+ *   stack only ever sees fully checksummed or validated packets.
+ *
+ ****************************************************************************/
+
+static void virtio_net_rxoffload(FAR struct netdev_lowerhalf_s *dev,
+                                 FAR netpkt_t *pkt,
+                                 FAR struct virtio_net_hdr_s *vhdr)
+{
+  uint16_t offset;
+  uint16_t sum;
+
+  pkt->io_offload = 0;
+
+  if ((vhdr->flags & VIRTIO_NET_HDR_F_NEEDS_CSUM) != 0)
+    {
+      /* csum_start is relative to the Ethernet header, while the iob data
+       * starts at the IP header.
+       */
+
+      if (vhdr->csum_start < ETH_HDRLEN ||
+          vhdr->csum_start + vhdr->csum_offset + sizeof(uint16_t) >
+          netpkt_getdatalen(dev, pkt))
+        {
+          return;
+        }
+
+      offset = vhdr->csum_start - ETH_HDRLEN;
+      sum    = chksum_iob(0, pkt, offset);
+      sum    = (sum == 0) ? 0xffff : HTONS(sum);
+      sum    = ~sum;
+
+      iob_trycopyin(pkt, (FAR const uint8_t *)&sum, sizeof(sum),
+                    offset + vhdr->csum_offset, false);
+      pkt->io_offload = NETPKT_CSUM_VALID;
+    }
+  else if ((vhdr->flags & VIRTIO_NET_HDR_F_DATA_VALID) != 0)
+    {
+      pkt->io_offload = NETPKT_CSUM_VALID;
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: virtio_net_addbuffer
  ****************************************************************************/
@@ -215,14 +350,15 @@ static int virtio_net_addbuffer(FAR struct netdev_lowerhalf_s *dev,
 {
   FAR struct virtio_net_priv_s *priv = (FAR struct virtio_net_priv_s *)dev;
   FAR struct virtio_net_llhdr_s *hdr;
-  struct virtqueue_buf vb[VIRTIO_NET_MAX_NIOB + 1];
-  struct iovec iov[VIRTIO_NET_MAX_NIOB];
+  struct virtqueue_buf vb[VIRTIO_NET_TX_MAX_NIOB + 1];
+  struct iovec iov[VIRTIO_NET_TX_MAX_NIOB];
   int iov_cnt;
   int i;
 
   /* Convert netpkt to virtqueue_buf */
 
-  iov_cnt = netpkt_to_iov(dev, pkt, iov, VIRTIO_NET_MAX_NIOB);
+  iov_cnt = netpkt_to_iov(dev, pkt, iov, vq_id == VIRTIO_NET_RX ?
+                          VIRTIO_NET_MAX_NIOB : VIRTIO_NET_TX_MAX_NIOB);
 
   /* Alloc cookie and net header from transport layer */
 
@@ -232,6 +368,13 @@ static int virtio_net_addbuffer(FAR struct netdev_lowerhalf_s *dev,
   memset(&hdr->vhdr, 0, sizeof(hdr->vhdr));
   hdr->pkt = pkt;
 
+#ifdef CONFIG_NETDEV_OFFLOAD
+  if (vq_id == VIRTIO_NET_TX)
+    {
+      virtio_net_txoffload(dev, pkt, &hdr->vhdr);
+    }
+#endif
+
   /* Prepare buffers depends on the feature VIRTIO_F_ANY_LAYOUT */
 
   if (virtio_has_feature(priv->vdev, VIRTIO_F_ANY_LAYOUT))
@@ -241,7 +384,7 @@ static int virtio_net_addbuffer(FAR struct netdev_lowerhalf_s *dev,
       vb[0].buf = &hdr->vhdr;
       vb[0].len = iov[0].iov_len + VIRTIO_NET_HDRSIZE;
 
-#if VIRTIO_NET_MAX_NIOB > 1
+#if VIRTIO_NET_TX_MAX_NIOB > 1
       for (i = 1; i < iov_cnt; i++)
         {
           vb[i].buf = iov[i].iov_base;
@@ -426,7 +569,7 @@ static int virtio_net_send(FAR struct netdev_lowerhalf_s *dev,
 
   /* Check the send length */
 
-  if (netpkt_getdatalen(dev, pkt) > VIRTIO_NET_BUFSIZE)
+  if (netpkt_getdatalen(dev, pkt) > VIRTIO_NET_TX_BUFSIZE)
     {
       vrterr("net send buffer too large\n");
       return -EINVAL;
@@ -489,6 +632,9 @@ static netpkt_t *virtio_net_recv(FAR struct netdev_lowerhalf_s *dev)
   /* Set the received pkt length */
 
   netpkt_setdatalen(dev, hdr->pkt, len - VIRTIO_NET_HDRSIZE);
+#ifdef CONFIG_NETDEV_OFFLOAD
+  virtio_net_rxoffload(dev, hdr->pkt, &hdr->vhdr);
+#endif
   vrtinfo("Recv, hdr=%p, pkt=%p, len=%" PRIu32 "\n", hdr, hdr->pkt, len);
   return hdr->pkt;
 }
@@ -571,6 +717,12 @@ static int virtio_net_init(FAR struct virtio_net_priv_s *priv,
 
   virtio_set_status(vdev, VIRTIO_CONFIG_STATUS_DRIVER);
   virtio_negotiate_features(vdev, (1UL << VIRTIO_NET_F_MAC) |
+#ifdef CONFIG_NETDEV_OFFLOAD
+                                  (1UL << VIRTIO_NET_F_CSUM) |
+                                  (1UL << VIRTIO_NET_F_GUEST_CSUM) |
+                                  (1UL << VIRTIO_NET_F_HOST_TSO4) |
+                                  (1UL << VIRTIO_NET_F_HOST_TSO6) |
+#endif
                                   (1UL << VIRTIO_F_ANY_LAYOUT), NULL);
   virtio_set_status(vdev, VIRTIO_CONFIG_FEATURES_OK);
 
@@ -601,6 +753,20 @@ static int virtio_net_init(FAR struct virtio_net_priv_s *priv,
                      (VIRTIO_NET_MAX_NIOB + 1), priv->bufnum);
   priv->bufnum = MIN(vdev->vrings_info[VIRTIO_NET_TX].info.num_descs /
                      (VIRTIO_NET_MAX_NIOB + 1), priv->bufnum);
+  priv->txbufnum = priv->bufnum;
+
+#ifdef CONFIG_NETDEV_OFFLOAD
+  /* A TSO super-frame takes many more descriptors of the TX ring, only
+   * the TX side is limited by it.
+   */
+
+  if (virtio_net_has_tso(vdev))
+    {
+      priv->txbufnum = MIN(vdev->vrings_info[VIRTIO_NET_TX].info.num_descs /
+                           (VIRTIO_NET_TX_MAX_NIOB + 1), priv->bufnum);
+    }
+#endif
+
   return OK;
 }
 
@@ -669,9 +835,28 @@ static int virtio_net_probe(FAR struct virtio_device *vdev)
 
   netdev = (FAR struct netdev_lowerhalf_s *)priv;
   netdev->quota[NETPKT_RX] = priv->bufnum;
-  netdev->quota[NETPKT_TX] = priv->bufnum;
+  netdev->quota[NETPKT_TX] = priv->txbufnum;
   netdev->ops = &g_virtio_net_ops;
 
+#ifdef CONFIG_NETDEV_OFFLOAD
+  /* Advertise the negotiated offloads */
+
+  if (virtio_has_feature(vdev, VIRTIO_NET_F_CSUM))
+    {
+      netdev->netdev.d_features |= NETDEV_F_TXCSUM;
+    }
+
+  if (virtio_net_has_tso(vdev))
+    {
+      netdev->netdev.d_features |= NETDEV_F_TSO;
+    }
+
+  if (virtio_has_feature(vdev, VIRTIO_NET_F_GUEST_CSUM))
+    {
+      netdev->netdev.d_features |= NETDEV_F_RXCSUM;
+    }
+#endif
+
 #ifdef CONFIG_DRIVERS_WIFI_SIM
   /* If the WiFi interfaces has reached the setting value,
    * no more WiFi interfaces will be created.
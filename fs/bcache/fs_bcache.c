@@ -0,0 +1,905 @@
+/****************************************************************************
+ * fs/bcache/fs_bcache.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/list.h>
+#include <nuttx/mutex.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/fs/bcache.h>
+
+#ifdef CONFIG_FS_BCACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define BCACHE_HASH(inode, sector) \
+  ((((uintptr_t)(inode) >> 4) ^ (uintptr_t)(sector)) % CONFIG_FS_BCACHE_NHASH)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One sector held in the cache.
+ *
+ * The cache lock is never held while a block driver is called: a block
+ * driver may itself be backed by a file on a cached volume (loop device),
+ * whose accesses come back into the cache.  A block whose data is being
+ * transferred is marked busy instead.  A busy block is not reused nor
+ * modified, and one being read is not valid yet.
+ */
+
+struct bcache_block_s
+{
+  struct list_node lru;       /* LRU list, most recently used first */
+  struct list_node hash;      /* Hash chain of the sector */
+  FAR struct inode *inode;    /* The block driver, NULL if unused */
+  blkcnt_t sector;            /* The sector held */
+  uint32_t seq;               /* Last bcache_flush() pass that wrote it */
+  bool dirty;                 /* Not yet written back */
+  bool busy;                  /* Being read or written back */
+  bool valid;                 /* data holds the sector */
+  unsigned char data[CONFIG_FS_BCACHE_SECTORSIZE];
+};
+
+/* The state of the buffer cache */
+
+struct bcache_s
+{
+  mutex_t lock;               /* Protects the whole cache */
+  sem_t wait;                 /* Waits for a busy block */
+  unsigned int nwaiters;      /* Number of threads waiting on wait */
+  unsigned int nalloc;        /* Number of blocks allocated */
+  uint32_t seq;               /* bcache_flush() pass number */
+  struct list_node lru;       /* All blocks, unused ones at the tail */
+  struct list_node hash[CONFIG_FS_BCACHE_NHASH];
+  struct work_s work;         /* Delayed write back */
+  struct bcache_stats_s stats;
+};
+
+/* A multi-sector transfer, as seen by the bcache_foreach() handlers */
+
+struct bcache_xfer_s
+{
+  FAR unsigned char *buffer;  /* The transfer buffer */
+  blkcnt_t start;             /* The first sector of the transfer */
+  blksize_t sectsize;         /* The size of one sector */
+  blkcnt_t written;           /* Number of sectors written to the media */
+};
+
+/* Callback of bcache_foreach(), returns true to stop the iteration */
+
+typedef CODE bool (*bcache_foreach_t)(FAR struct bcache_block_s *blk,
+                                      FAR void *arg);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct bcache_s g_bcache =
+{
+  NXMUTEX_INITIALIZER,
+  SEM_INITIALIZER(0)
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: bcache_wait
+ *
+ * Description:
+ *   Wait until a busy block is released.  The lock is released while
+ *   waiting, anything found before may have changed on return.
+ *
+ * Assumptions:
+ *   The cache is locked.
+ *
+ ****************************************************************************/
+
+static void bcache_wait(void)
+{
+  g_bcache.nwaiters++;
+  nxmutex_unlock(&g_bcache.lock);
+  nxsem_wait_uninterruptible(&g_bcache.wait);
+  nxmutex_lock(&g_bcache.lock);
+}
+
+/****************************************************************************
+ * Name: bcache_release
+ *
+ * Description:
+ *   Clear the busy mark of a block and wake up the threads waiting for it.
+ *
+ * Assumptions:
+ *   The cache is locked.
+ *
+ ****************************************************************************/
+
+static void bcache_release(FAR struct bcache_block_s *blk)
+{
+  blk->busy = false;
+  while (g_bcache.nwaiters > 0)
+    {
+      g_bcache.nwaiters--;
+      nxsem_post(&g_bcache.wait);
+    }
+}
+
+/****************************************************************************
+ * Name: bcache_find
+ *
+ * Description:
+ *   Find a sector in the cache and make it the most recently used one.
+ *
+ * Assumptions:
+ *   The cache is locked.
+ *
+ ****************************************************************************/
+
+static FAR struct bcache_block_s *bcache_find(FAR struct inode *inode,
+                                              blkcnt_t sector)
+{
+  FAR struct list_node *chain = &g_bcache.hash[BCACHE_HASH(inode, sector)];
+  FAR struct bcache_block_s *blk;
+
+  list_for_every_entry(chain, blk, struct bcache_block_s, hash)
+    {
+      if (blk->inode == inode && blk->sector == sector)
+        {
+          list_delete(&blk->lru);
+          list_add_head(&g_bcache.lru, &blk->lru);
+          return blk;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: bcache_foreach
+ *
+ * Description:
+ *   Call 'handler' for the cached sectors of a block driver in the range
+ *   [start, start + nsectors), in no particular order.  Short ranges are
+ *   looked up in the hash table, the LRU list is only walked when it is
+ *   shorter than the range.
+ *
+ * Returned Value:
+ *   true if 'handler' stopped the iteration.
+ *
+ * Assumptions:
+ *   The cache is locked.  'handler' does not release it.
+ *
+ ****************************************************************************/
+
+static bool bcache_foreach(FAR struct inode *inode, blkcnt_t start,
+                           blkcnt_t nsectors, bcache_foreach_t handler,
+                           FAR void *arg)
+{
+  FAR struct bcache_block_s *blk;
+  FAR struct list_node *chain;
+  blkcnt_t sector;
+
+  if (g_bcache.stats.nblocks == 0)
+    {
+      return false;
+    }
+
+  if (nsectors > g_bcache.stats.nblocks)
+    {
+      list_for_every_entry(&g_bcache.lru, blk, struct bcache_block_s, lru)
+        {
+          if (blk->inode == inode && blk->sector >= start &&
+              blk->sector < start + nsectors && handler(blk, arg))
+            {
+              return true;
+            }
+        }
+
+      return false;
+    }
+
+  for (sector = start; sector < start + nsectors; sector++)
+    {
+      chain = &g_bcache.hash[BCACHE_HASH(inode, sector)];
+      list_for_every_entry(chain, blk, struct bcache_block_s, hash)
+        {
+          if (blk->inode == inode && blk->sector == sector)
+            {
+              if (handler(blk, arg))
+                {
+                  return true;
+                }
+
+              break;
+            }
+        }
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: bcache_writeback
+ *
+ * Description:
+ *   Write a dirty sector to its block driver.  The block is busy while the
+ *   cache is unlocked for the write.
+ *
+ * Assumptions:
+ *   The cache is locked, the block is dirty and not busy.
+ *
+ ****************************************************************************/
+
+static int bcache_writeback(FAR struct bcache_block_s *blk)
+{
+  FAR struct inode *inode = blk->inode;
+  ssize_t ret;
+
+  blk->busy = true;
+  nxmutex_unlock(&g_bcache.lock);
+
+  ret = inode->u.i_bops->write(inode, blk->data, blk->sector, 1);
+
+  nxmutex_lock(&g_bcache.lock);
+  bcache_release(blk);
+
+  if (ret != 1)
+    {
+      ferr("ERROR: Write back of sector %" PRIuOFF " failed: %zd\n",
+           (off_t)blk->sector, ret);
+      return ret < 0 ? (int)ret : -EIO;
+    }
+
+  blk->dirty = false;
+  g_bcache.stats.ndirty--;
+  g_bcache.stats.writebacks++;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bcache_setdirty
+ *
+ * Description:
+ *   Mark a sector as dirty and schedule its write back.
+ *
+ * Assumptions:
+ *   The cache is locked.
+ *
+ ****************************************************************************/
+
+static void bcache_worker(FAR void *arg);
+
+static void bcache_setdirty(FAR struct bcache_block_s *blk)
+{
+  if (!blk->dirty)
+    {
+      blk->dirty = true;
+      g_bcache.stats.ndirty++;
+    }
+
+  if (work_available(&g_bcache.work))
+    {
+      work_queue(LPWORK, &g_bcache.work, bcache_worker, NULL,
+                 MSEC2TICK(CONFIG_FS_BCACHE_FLUSH_DELAY));
+    }
+}
+
+/****************************************************************************
+ * Name: bcache_drop
+ *
+ * Description:
+ *   Forget the sector held by a block, the block becomes the first one to
+ *   be reused.
+ *
+ * Assumptions:
+ *   The cache is locked and the block is not busy.
+ *
+ ****************************************************************************/
+
+static void bcache_drop(FAR struct bcache_block_s *blk)
+{
+  if (blk->dirty)
+    {
+      blk->dirty = false;
+      g_bcache.stats.ndirty--;
+    }
+
+  blk->inode = NULL;
+  blk->valid = false;
+  g_bcache.stats.nblocks--;
+
+  list_delete_init(&blk->hash);
+  list_delete(&blk->lru);
+  list_add_tail(&g_bcache.lru, &blk->lru);
+}
+
+/****************************************************************************
+ * Name: bcache_get
+ *
+ * Description:
+ *   Get the block of a sector.  If the sector is not cached, a block is
+ *   taken for it: until the configured number of blocks is reached a new
+ *   block is allocated, then the least recently used block that is not
+ *   busy is reused, after writing it back if needed.
+ *
+ * Input Parameters:
+ *   inode  - The block driver
+ *   sector - The sector
+ *   modify - The block data is going to be modified: wait until the
+ *            block is not busy at all, not only until it is valid.
+ *
+ * Returned Value:
+ *   The block, not valid if it was just taken for the sector, or NULL if
+ *   no block is available.
+ *
+ * Assumptions:
+ *   The cache is locked.  It may be released and locked again.
+ *
+ ****************************************************************************/
+
+static FAR struct bcache_block_s *bcache_get(FAR struct inode *inode,
+                                             blkcnt_t sector, bool modify)
+{
+  FAR struct bcache_block_s *blk;
+  FAR struct bcache_block_s *victim;
+
+  for (; ; )
+    {
+      blk = bcache_find(inode, sector);
+      if (blk != NULL)
+        {
+          if (!blk->valid || (modify && blk->busy))
+            {
+              bcache_wait();
+              continue;
+            }
+
+          return blk;
+        }
+
+      victim = NULL;
+      if (g_bcache.nalloc < CONFIG_FS_BCACHE_NBLOCKS)
+        {
+          victim = list_peek_tail_type(&g_bcache.lru,
+                                       struct bcache_block_s, lru);
+          if (victim == NULL || victim->inode != NULL)
+            {
+              victim = kmm_malloc(sizeof(struct bcache_block_s));
+              if (victim != NULL)
+                {
+                  victim->inode = NULL;
+                  victim->dirty = false;
+                  victim->busy  = false;
+                  victim->valid = false;
+                  victim->seq   = 0;
+                  list_clear_node(&victim->hash);
+                  list_add_tail(&g_bcache.lru, &victim->lru);
+                  g_bcache.nalloc++;
+                }
+            }
+        }
+
+      if (victim == NULL)
+        {
+          list_for_every_entry_reverse(&g_bcache.lru, blk,
+                                       struct bcache_block_s, lru)
+            {
+              if (!blk->busy)
+                {
+                  victim = blk;
+                  break;
+                }
+            }
+
+          if (victim == NULL)
+            {
+              return NULL;
+            }
+        }
+
+      if (victim->inode == NULL)
+        {
+          break;
+        }
+
+      if (victim->dirty)
+        {
+          /* The lock was released for the write back, look again */
+
+          if (bcache_writeback(victim) < 0)
+            {
+              return NULL;
+            }
+
+          continue;
+        }
+
+      bcache_drop(victim);
+      break;
+    }
+
+  victim->inode  = inode;
+  victim->sector = sector;
+  g_bcache.stats.nblocks++;
+
+  list_add_head(&g_bcache.hash[BCACHE_HASH(inode, sector)], &victim->hash);
+  list_delete(&victim->lru);
+  list_add_head(&g_bcache.lru, &victim->lru);
+  return victim;
+}
+
+/****************************************************************************
+ * Name: bcache_overlay
+ *
+ * Description:
+ *   bcache_foreach() handler copying a cached sector over the data read
+ *   from the media.
+ *
+ ****************************************************************************/
+
+static bool bcache_overlay(FAR struct bcache_block_s *blk, FAR void *arg)
+{
+  FAR struct bcache_xfer_s *xfer = arg;
+
+  /* The cached copy is at least as recent as the media, even if clean: it
+   * may have been written back after the media was read.
+   */
+
+  if (blk->valid)
+    {
+      memcpy(xfer->buffer + (blk->sector - xfer->start) * xfer->sectsize,
+             blk->data, xfer->sectsize);
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: bcache_isbusy
+ *
+ * Description:
+ *   bcache_foreach() handler stopping on a busy block.
+ *
+ ****************************************************************************/
+
+static bool bcache_isbusy(FAR struct bcache_block_s *blk, FAR void *arg)
+{
+  return blk->busy;
+}
+
+/****************************************************************************
+ * Name: bcache_update
+ *
+ * Description:
+ *   bcache_foreach() handler copying the data of a write into a cached
+ *   sector.  The copy is dirty until the write to the media completes.
+ *
+ ****************************************************************************/
+
+static bool bcache_update(FAR struct bcache_block_s *blk, FAR void *arg)
+{
+  FAR struct bcache_xfer_s *xfer = arg;
+
+  memcpy(blk->data, xfer->buffer + (blk->sector - xfer->start) *
+         xfer->sectsize, xfer->sectsize);
+  blk->valid = true;
+  bcache_setdirty(blk);
+  return false;
+}
+
+/****************************************************************************
+ * Name: bcache_written
+ *
+ * Description:
+ *   bcache_foreach() handler marking clean a cached sector that was
+ *   written to the media, unless it was modified or is being written
+ *   back meanwhile.
+ *
+ ****************************************************************************/
+
+static bool bcache_written(FAR struct bcache_block_s *blk, FAR void *arg)
+{
+  FAR struct bcache_xfer_s *xfer = arg;
+
+  if (blk->dirty && !blk->busy && blk->sector < xfer->start +
+      xfer->written && memcmp(blk->data, xfer->buffer + (blk->sector -
+      xfer->start) * xfer->sectsize, xfer->sectsize) == 0)
+    {
+      blk->dirty = false;
+      g_bcache.stats.ndirty--;
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: bcache_worker
+ *
+ * Description:
+ *   Write back all the dirty sectors, some time after the first of them
+ *   was written.
+ *
+ ****************************************************************************/
+
+static void bcache_worker(FAR void *arg)
+{
+  bcache_flush(NULL);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: bcache_initialize
+ *
+ * Description:
+ *   Initialize the buffer cache.  Called once by fs_initialize().
+ *
+ ****************************************************************************/
+
+void bcache_initialize(void)
+{
+  int i;
+
+  list_initialize(&g_bcache.lru);
+  for (i = 0; i < CONFIG_FS_BCACHE_NHASH; i++)
+    {
+      list_initialize(&g_bcache.hash[i]);
+    }
+}
+
+/****************************************************************************
+ * Name: bcache_read
+ *
+ * Description:
+ *   Read sectors of a block driver through the buffer cache.
+ *
+ ****************************************************************************/
+
+ssize_t bcache_read(FAR struct inode *inode, FAR unsigned char *buffer,
+                    blkcnt_t start, unsigned int nsectors,
+                    blksize_t sectsize)
+{
+  FAR struct bcache_block_s *blk;
+  struct bcache_xfer_s xfer;
+  ssize_t ret;
+
+  DEBUGASSERT(inode != NULL && inode->u.i_bops->read != NULL);
+
+  if (sectsize > CONFIG_FS_BCACHE_SECTORSIZE)
+    {
+      return inode->u.i_bops->read(inode, buffer, start, nsectors);
+    }
+
+  if (nsectors != 1)
+    {
+      /* Large transfers do not go through the cache, so that streaming
+       * does not evict the metadata.  The cached sectors are at least as
+       * recent as the media.
+       */
+
+      ret = inode->u.i_bops->read(inode, buffer, start, nsectors);
+      if (ret <= 0)
+        {
+          return ret;
+        }
+
+      xfer.buffer   = buffer;
+      xfer.start    = start;
+      xfer.sectsize = sectsize;
+
+      nxmutex_lock(&g_bcache.lock);
+      bcache_foreach(inode, start, ret, bcache_overlay, &xfer);
+      nxmutex_unlock(&g_bcache.lock);
+      return ret;
+    }
+
+  ret = nxmutex_lock(&g_bcache.lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  blk = bcache_get(inode, start, false);
+  if (blk == NULL)
+    {
+      nxmutex_unlock(&g_bcache.lock);
+      return inode->u.i_bops->read(inode, buffer, start, 1);
+    }
+
+  if (blk->valid)
+    {
+      g_bcache.stats.hits++;
+    }
+  else
+    {
+      g_bcache.stats.misses++;
+
+      blk->busy = true;
+      nxmutex_unlock(&g_bcache.lock);
+
+      ret = inode->u.i_bops->read(inode, blk->data, start, 1);
+
+      nxmutex_lock(&g_bcache.lock);
+      bcache_release(blk);
+
+      if (ret != 1)
+        {
+          bcache_drop(blk);
+          goto out;
+        }
+
+      blk->valid = true;
+    }
+
+  memcpy(buffer, blk->data, sectsize);
+  ret = 1;
+
+out:
+  nxmutex_unlock(&g_bcache.lock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: bcache_write
+ *
+ * Description:
+ *   Write sectors of a block driver through the buffer cache.
+ *
+ ****************************************************************************/
+
+ssize_t bcache_write(FAR struct inode *inode,
+                     FAR const unsigned char *buffer, blkcnt_t start,
+                     unsigned int nsectors, blksize_t sectsize)
+{
+  FAR struct bcache_block_s *blk;
+  struct bcache_xfer_s xfer;
+  ssize_t ret;
+
+  DEBUGASSERT(inode != NULL && inode->u.i_bops->write != NULL);
+
+  if (sectsize > CONFIG_FS_BCACHE_SECTORSIZE)
+    {
+      return inode->u.i_bops->write(inode, buffer, start, nsectors);
+    }
+
+  ret = nxmutex_lock(&g_bcache.lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (nsectors != 1)
+    {
+      /* Large transfers are written through.  The cached copies are
+       * updated first and stay dirty until the write completes, so that a
+       * write back running meanwhile cannot leave older data on the media,
+       * and those that could not be written are retried later.
+       */
+
+      xfer.buffer   = (FAR unsigned char *)buffer;
+      xfer.start    = start;
+      xfer.sectsize = sectsize;
+
+      while (bcache_foreach(inode, start, nsectors, bcache_isbusy, NULL))
+        {
+          bcache_wait();
+        }
+
+      bcache_foreach(inode, start, nsectors, bcache_update, &xfer);
+      nxmutex_unlock(&g_bcache.lock);
+
+      ret = inode->u.i_bops->write(inode, buffer, start, nsectors);
+
+      if (ret > 0)
+        {
+          xfer.written = ret;
+
+          nxmutex_lock(&g_bcache.lock);
+          bcache_foreach(inode, start, ret, bcache_written, &xfer);
+          nxmutex_unlock(&g_bcache.lock);
+        }
+
+      return ret;
+    }
+
+  /* A single sector is written back later, there is no need to read it
+   * as it is overwritten as a whole.
+   */
+
+  blk = bcache_get(inode, start, true);
+  if (blk == NULL)
+    {
+      nxmutex_unlock(&g_bcache.lock);
+      return inode->u.i_bops->write(inode, buffer, start, 1);
+    }
+
+  memcpy(blk->data, buffer, sectsize);
+  blk->valid = true;
+  bcache_setdirty(blk);
+
+  nxmutex_unlock(&g_bcache.lock);
+  return 1;
+}
+
+/****************************************************************************
+ * Name: bcache_flush
+ *
+ * Description:
+ *   Write back the dirty sectors of a block driver, or of all of them if
+ *   inode is NULL.
+ *
+ ****************************************************************************/
+
+int bcache_flush(FAR struct inode *inode)
+{
+  FAR struct bcache_block_s *blk;
+  FAR struct bcache_block_s *next;
+  int result = OK;
+  uint32_t seq;
+  int ret;
+
+  ret = nxmutex_lock(&g_bcache.lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* The list may change whenever the lock is released for a write, the
+   * scan starts over each time.  The pass number skips the sectors that
+   * already failed in this pass.
+   */
+
+  seq = ++g_bcache.seq;
+
+  for (; ; )
+    {
+      next = NULL;
+
+      /* Write the oldest sectors first */
+
+      list_for_every_entry_reverse(&g_bcache.lru, blk,
+                                   struct bcache_block_s, lru)
+        {
+          if (blk->dirty && blk->seq != seq &&
+              (inode == NULL || blk->inode == inode))
+            {
+              next = blk;
+              break;
+            }
+        }
+
+      if (next == NULL)
+        {
+          break;
+        }
+
+      if (next->busy)
+        {
+          /* Being written back by someone else, wait for the result */
+
+          bcache_wait();
+          continue;
+        }
+
+      next->seq = seq;
+      ret = bcache_writeback(next);
+      if (ret < 0 && result == OK)
+        {
+          result = ret;
+        }
+    }
+
+  nxmutex_unlock(&g_bcache.lock);
+  return result;
+}
+
+/****************************************************************************
+ * Name: bcache_invalidate
+ *
+ * Description:
+ *   Drop all the sectors of a block driver from the cache.
+ *
+ ****************************************************************************/
+
+void bcache_invalidate(FAR struct inode *inode)
+{
+  FAR struct bcache_block_s *blk;
+  FAR struct bcache_block_s *tmp;
+  bool busy;
+
+  DEBUGASSERT(inode != NULL);
+
+  nxmutex_lock(&g_bcache.lock);
+
+  do
+    {
+      busy = false;
+      list_for_every_entry_safe(&g_bcache.lru, blk, tmp,
+                                struct bcache_block_s, lru)
+        {
+          if (blk->inode != inode)
+            {
+              continue;
+            }
+
+          if (blk->busy)
+            {
+              busy = true;
+              continue;
+            }
+
+          if (blk->dirty)
+            {
+              fwarn("WARNING: Dropping dirty sector %" PRIuOFF "\n",
+                    (off_t)blk->sector);
+            }
+
+          bcache_drop(blk);
+        }
+
+      if (busy)
+        {
+          bcache_wait();
+        }
+    }
+  while (busy);
+
+  nxmutex_unlock(&g_bcache.lock);
+}
+
+/****************************************************************************
+ * Name: bcache_getstats
+ *
+ * Description:
+ *   Get the statistics of the buffer cache.
+ *
+ ****************************************************************************/
+
+void bcache_getstats(FAR struct bcache_stats_s *stats)
+{
+  nxmutex_lock(&g_bcache.lock);
+  *stats = g_bcache.stats;
+  nxmutex_unlock(&g_bcache.lock);
+}
+
+#endif /* CONFIG_FS_BCACHE */
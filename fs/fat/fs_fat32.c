@@ -30,6 +30,7 @@
 #include <sys/stat.h>
 #include <sys/statfs.h>
 #include <sys/mount.h>
+#include <sys/param.h>
 
 #include <stdlib.h>
 #include <unistd.h>
@@ -41,6 +42,7 @@
 
 #include <nuttx/kmalloc.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/bcache.h>
 #include <nuttx/fs/fat.h>
 
 #include "inode/inode.h"
@@ -113,6 +115,7 @@ static int     fat_stat_root(FAR struct fat_mountpt_s *fs,
                  FAR struct stat *buf);
 static int     fat_stat(struct inode *mountpt, const char *relpath,
                  FAR struct stat *buf);
+static int     fat_syncfs(FAR struct inode *mountpt);
 
 /****************************************************************************
  * Public Data
@@ -156,7 +159,8 @@ const struct mountpt_operations g_fat_operations =
   fat_rmdir,         /* rmdir */
   fat_rename,        /* rename */
   fat_stat,          /* stat */
-  NULL               /* chstat */
+  NULL,              /* chstat */
+  fat_syncfs         /* syncfs */
 };
 
 /****************************************************************************
@@ -472,6 +476,14 @@ static int fat_close(FAR struct file *filep)
       fat_io_free(ff->ff_buffer, fs->fs_hwsectorsize);
     }
 
+#ifdef CONFIG_FAT_RWBUFFER
+  if (ff->ff_rwbuffer)
+    {
+      fat_io_free(ff->ff_rwbuffer,
+                  CONFIG_FAT_RWBUFFER_NSECTORS * fs->fs_hwsectorsize);
+    }
+#endif
+
   /* Then free the file structure itself. */
 
   fs_heap_free(ff);
@@ -620,6 +632,27 @@ static int fat_get_sectors(FAR struct file *filep, bool read)
       num_traversed = 1;
     }
 
+#ifdef CONFIG_FAT_EXTENT_CACHE
+  /* Skip as much of the chain as the extent cache already knows about */
+
+  if (ff->ff_startcluster != 0)
+    {
+      uint32_t extindex;
+      uint32_t extcluster;
+
+      fat_extentadd(fs, ff, 0, ff->ff_startcluster);
+
+      i = MIN(num_clu, new_num_clu);
+      if (i > num_traversed &&
+          fat_extentlookup(fs, ff, i - 1, &extindex, &extcluster) == OK &&
+          (int)extindex + 1 > num_traversed)
+        {
+          cluster = extcluster;
+          num_traversed = extindex + 1;
+        }
+    }
+#endif
+
   /* Traverse the existing chain */
 
   for (i = num_traversed; i < num_clu && i < new_num_clu; i++)
@@ -632,6 +665,10 @@ static int fat_get_sectors(FAR struct file *filep, bool read)
         {
           return -EIO;
         }
+
+#ifdef CONFIG_FAT_EXTENT_CACHE
+      fat_extentadd(fs, ff, i, cluster);
+#endif
     }
 
   if (read)
@@ -684,6 +721,10 @@ static int fat_get_sectors(FAR struct file *filep, bool read)
           return -EIO;
         }
 
+#ifdef CONFIG_FAT_EXTENT_CACHE
+      fat_extentadd(fs, ff, i, cluster);
+#endif
+
       /* zero area (2) */
 
       ret = fat_zero_cluster(fs, cluster, 0, clu_size);
@@ -707,6 +748,10 @@ static int fat_get_sectors(FAR struct file *filep, bool read)
           return -EIO;
         }
 
+#ifdef CONFIG_FAT_EXTENT_CACHE
+      fat_extentadd(fs, ff, i, cluster);
+#endif
+
       /* zero area (3) */
 
       zero_end = filep->f_pos & (clu_size -1);
@@ -744,6 +789,231 @@ out:
   return 0;
 }
 
+#ifdef CONFIG_FAT_RWBUFFER
+/****************************************************************************
+ * Name: fat_rwbuffer_alloc
+ *
+ * Description:
+ *   Allocate the readahead / write-behind buffer of an open file on first
+ *   use.  Failure is not an error:  The file is then accessed one sector
+ *   at a time as before.
+ *
+ ****************************************************************************/
+
+static bool fat_rwbuffer_alloc(FAR struct fat_mountpt_s *fs,
+                               FAR struct fat_file_s *ff)
+{
+  if (ff->ff_rwbuffer == NULL)
+    {
+      ff->ff_rwbuffer = (FAR uint8_t *)
+        fat_io_alloc(CONFIG_FAT_RWBUFFER_NSECTORS * fs->fs_hwsectorsize);
+    }
+
+  return ff->ff_rwbuffer != NULL;
+}
+
+/****************************************************************************
+ * Name: fat_rwbuffer_read
+ *
+ * Description:
+ *   Satisfy (part of) a read from the readahead buffer, refilling it first
+ *   if the read continues sequentially where the previous one stopped.
+ *   Sector aligned reads of whole sectors still go straight to the user
+ *   buffer.
+ *
+ * Input Parameters:
+ *   filep       - The open file; fat_get_sectors() has located f_pos
+ *   userbuffer  - Where to copy the data
+ *   buflen      - The number of bytes still wanted
+ *   sectorindex - The offset of f_pos in the current sector
+ *
+ * Returned Value:
+ *   The number of bytes copied, zero if the buffer cannot help, or a
+ *   negated errno value on a read failure.
+ *
+ ****************************************************************************/
+
+static ssize_t fat_rwbuffer_read(FAR struct file *filep,
+                                 FAR uint8_t *userbuffer, size_t buflen,
+                                 int sectorindex)
+{
+  FAR struct fat_mountpt_s *fs = filep->f_inode->i_private;
+  FAR struct fat_file_s *ff = filep->f_priv;
+  unsigned int nsectors;
+  uint32_t cluster;
+  off_t next;
+  off_t offset;
+  size_t nbytes;
+  int ret;
+
+  if (ff->ff_rwnsectors == 0 ||
+      ff->ff_currentsector < ff->ff_rwsector ||
+      ff->ff_currentsector >= ff->ff_rwsector + ff->ff_rwnsectors)
+    {
+      if (filep->f_pos != ff->ff_rdnext ||
+          (sectorindex == 0 && buflen >= fs->fs_hwsectorsize) ||
+          !fat_rwbuffer_alloc(fs, ff))
+        {
+          return 0;
+        }
+
+      /* A dirty sector in the file buffer must reach the media first */
+
+      ret = fat_ffcacheflush(fs, ff);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      /* Read ahead through the rest of this cluster and any clusters that
+       * follow it physically, but not past the end of the file.
+       */
+
+      nsectors = ff->ff_sectorsincluster;
+      cluster  = ff->ff_currentcluster;
+      while (nsectors < CONFIG_FAT_RWBUFFER_NSECTORS)
+        {
+          next = fat_getcluster(fs, cluster);
+          if (next != cluster + 1)
+            {
+              break;
+            }
+
+          nsectors += fs->fs_fatsecperclus;
+          cluster   = next;
+        }
+
+      nsectors = MIN(nsectors, CONFIG_FAT_RWBUFFER_NSECTORS);
+      nsectors = MIN(nsectors,
+                     SEC_NSECTORS(fs, ff->ff_size - filep->f_pos +
+                                  sectorindex + SEC_NDXMASK(fs)));
+
+      ff->ff_rwnsectors = 0;
+      ret = fat_hwread(fs, ff->ff_rwbuffer, ff->ff_currentsector, nsectors);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      ff->ff_rwsector   = ff->ff_currentsector;
+      ff->ff_rwnsectors = nsectors;
+    }
+
+  offset = (ff->ff_currentsector - ff->ff_rwsector) * fs->fs_hwsectorsize +
+           sectorindex;
+  nbytes = ff->ff_rwnsectors * fs->fs_hwsectorsize - offset;
+  if (nbytes > buflen)
+    {
+      nbytes = buflen;
+    }
+
+  memcpy(userbuffer, &ff->ff_rwbuffer[offset], nbytes);
+  return nbytes;
+}
+
+/****************************************************************************
+ * Name: fat_rwbuffer_write
+ *
+ * Description:
+ *   Collect a small append in the write-behind buffer.  The buffer is
+ *   written back as one multi-sector transfer when it fills or when the
+ *   append stream stops being physically contiguous.
+ *
+ * Input Parameters:
+ *   filep       - The open file; fat_get_sectors() has located f_pos
+ *   userbuffer  - The data to write
+ *   buflen      - The number of bytes still to write
+ *   sectorindex - The offset of f_pos in the current sector
+ *
+ * Returned Value:
+ *   The number of bytes buffered, zero if the write must take the normal
+ *   path, or a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+static ssize_t fat_rwbuffer_write(FAR struct file *filep,
+                                  FAR const uint8_t *userbuffer,
+                                  size_t buflen, int sectorindex)
+{
+  FAR struct fat_mountpt_s *fs = filep->f_inode->i_private;
+  FAR struct fat_file_s *ff = filep->f_priv;
+  size_t capacity = CONFIG_FAT_RWBUFFER_NSECTORS * fs->fs_hwsectorsize;
+  size_t nbytes;
+  int ret;
+
+  /* Only continue buffering if this append picks up exactly where the
+   * buffered data stops.
+   */
+
+  if (ff->ff_rwbytes > 0 &&
+      (filep->f_pos != ff->ff_size ||
+       ff->ff_rwsector * fs->fs_hwsectorsize + ff->ff_rwbytes !=
+       ff->ff_currentsector * fs->fs_hwsectorsize + sectorindex))
+    {
+      ret = fat_ffrwflush(fs, ff);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  if (ff->ff_rwbytes == 0)
+    {
+      if (filep->f_pos != ff->ff_size ||
+          (sectorindex == 0 && buflen >= fs->fs_hwsectorsize) ||
+          !fat_rwbuffer_alloc(fs, ff))
+        {
+          return 0;
+        }
+
+      /* Write back the file buffer; it must not hold a stale copy of the
+       * sectors collected here.
+       */
+
+      ret = fat_ffcacheinvalidate(fs, ff);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      /* Keep the existing head of a partially written sector */
+
+      if (sectorindex != 0)
+        {
+          ret = fat_hwread(fs, ff->ff_rwbuffer, ff->ff_currentsector, 1);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+
+      ff->ff_rwsector = ff->ff_currentsector;
+      ff->ff_rwbytes  = sectorindex;
+    }
+
+  /* Do not run past the buffer or the end of the current cluster */
+
+  nbytes = MIN(buflen, capacity - ff->ff_rwbytes);
+  nbytes = MIN(nbytes, ff->ff_sectorsincluster * fs->fs_hwsectorsize -
+                       sectorindex);
+
+  memcpy(&ff->ff_rwbuffer[ff->ff_rwbytes], userbuffer, nbytes);
+  ff->ff_rwbytes += nbytes;
+  ff->ff_bflags  |= FFBUFF_MODIFIED;
+
+  if (ff->ff_rwbytes >= capacity)
+    {
+      ret = fat_ffrwflush(fs, ff);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  return nbytes;
+}
+#endif
+
 /****************************************************************************
  * Name: fat_read
  ****************************************************************************/
@@ -766,6 +1036,10 @@ static ssize_t fat_read(FAR struct file *filep, FAR char *buffer,
   bool force_indirect = false;
 #endif
 
+#ifdef CONFIG_FAT_RWBUFFER
+  ssize_t nread;
+#endif
+
   /* Sanity checks */
 
   DEBUGASSERT(filep->f_priv != NULL);
@@ -833,6 +1107,18 @@ static ssize_t fat_read(FAR struct file *filep, FAR char *buffer,
         }
     }
 
+#ifdef CONFIG_FAT_RWBUFFER
+  /* Appended data still in the write-behind buffer must be read back from
+   * the media.
+   */
+
+  ret = fat_ffrwflush(fs, ff);
+  if (ret < 0)
+    {
+      goto errout_with_lock;
+    }
+
+#endif
   /* Loop until either (1) all data has been transferred, or (2) an error
    * occurs.  We assume we start with the current sector (ff_currentsector)
    * which may be uninitialized.
@@ -851,6 +1137,20 @@ static ssize_t fat_read(FAR struct file *filep, FAR char *buffer,
           goto errout_with_lock;
         }
 
+#ifdef CONFIG_FAT_RWBUFFER
+      nread = fat_rwbuffer_read(filep, userbuffer, buflen, sectorindex);
+      if (nread < 0)
+        {
+          ret = nread;
+          goto errout_with_lock;
+        }
+      else if (nread > 0)
+        {
+          bytesread = nread;
+          goto fat_read_advance;
+        }
+#endif
+
 #ifdef CONFIG_FAT_DIRECT_RETRY /* Warning avoidance */
 fat_read_restart:
 #endif
@@ -948,6 +1248,10 @@ fat_read_restart:
           memcpy(userbuffer, &ff->ff_buffer[sectorindex], bytesread);
         }
 
+#ifdef CONFIG_FAT_RWBUFFER
+fat_read_advance:
+#endif
+
       /* Set up for the next sector read */
 
       userbuffer   += bytesread;
@@ -957,6 +1261,10 @@ fat_read_restart:
       sectorindex   = filep->f_pos & SEC_NDXMASK(fs);
     }
 
+#ifdef CONFIG_FAT_RWBUFFER
+  ff->ff_rdnext = filep->f_pos;
+#endif
+
   nxmutex_unlock(&fs->fs_lock);
   return readsize;
 
@@ -986,6 +1294,10 @@ static ssize_t fat_write(FAR struct file *filep, FAR const char *buffer,
   bool force_indirect = false;
 #endif
 
+#ifdef CONFIG_FAT_RWBUFFER
+  ssize_t nwritten;
+#endif
+
   DEBUGASSERT(filep->f_priv != NULL);
 
   /* Recover our private data from the struct file instance */
@@ -1034,6 +1346,12 @@ static ssize_t fat_write(FAR struct file *filep, FAR const char *buffer,
       goto errout_with_lock;
     }
 
+#ifdef CONFIG_FAT_RWBUFFER
+  /* Anything read ahead may be overwritten now */
+
+  ff->ff_rwnsectors = 0;
+
+#endif
   /* Loop until either (1) all data has been transferred, or (2) an
    * error occurs.  We assume we start with the current sector in
    * cache (ff_currentsector)
@@ -1050,6 +1368,21 @@ static ssize_t fat_write(FAR struct file *filep, FAR const char *buffer,
           goto errout_with_lock;
         }
 
+#ifdef CONFIG_FAT_RWBUFFER
+      nwritten = fat_rwbuffer_write(filep, userbuffer, buflen,
+                                    sectorindex);
+      if (nwritten < 0)
+        {
+          ret = nwritten;
+          goto errout_with_lock;
+        }
+      else if (nwritten > 0)
+        {
+          writesize = nwritten;
+          goto fat_write_advance;
+        }
+#endif
+
 #ifdef CONFIG_FAT_DIRECT_RETRY /* Warning avoidance */
 fat_write_restart:
 #endif
@@ -1189,6 +1522,10 @@ fat_write_restart:
           ff->ff_bflags |= (FFBUFF_DIRTY | FFBUFF_VALID | FFBUFF_MODIFIED);
         }
 
+#ifdef CONFIG_FAT_RWBUFFER
+fat_write_advance:
+#endif
+
       /* Set up for the next write */
 
       userbuffer   += writesize;
@@ -1492,6 +1829,13 @@ static int fat_sync(FAR struct file *filep)
       ret          = fat_updatefsinfo(fs);
     }
 
+  /* Write back the sectors left in the buffer cache */
+
+  if (ret >= 0)
+    {
+      ret = bcache_flush(fs->fs_blkdriver);
+    }
+
 errout_with_lock:
   nxmutex_unlock(&fs->fs_lock);
   return ret;
@@ -1599,6 +1943,15 @@ static int fat_dup(FAR const struct file *oldp, FAR struct file *newp)
   newff->ff_startcluster     = oldff->ff_startcluster;     /* Start cluster of file on media */
   newff->ff_currentsector    = oldff->ff_currentsector;    /* Current sector */
   newff->ff_cachesector      = 0;                          /* Sector in file buffer */
+#ifdef CONFIG_FAT_RWBUFFER
+  newff->ff_rwnsectors       = 0;                          /* Readahead */
+  newff->ff_rwbytes          = 0;                          /* Write-behind */
+  newff->ff_rdnext           = 0;                          /* Next read */
+  newff->ff_rwbuffer         = NULL;                       /* Buffer */
+#endif
+#ifdef CONFIG_FAT_EXTENT_CACHE
+  newff->ff_nextents         = 0;                          /* Extents */
+#endif
 
   /* Attach the private date to the struct file instance */
 
@@ -1882,6 +2235,16 @@ static int fat_truncate(FAR struct file *filep, off_t length)
       goto errout_with_lock;
     }
 
+#ifdef CONFIG_FAT_RWBUFFER
+  /* The buffered sectors may be about to leave the file */
+
+  ret = fat_ffrwinvalidate(fs, ff);
+  if (ret < 0)
+    {
+      goto errout_with_lock;
+    }
+
+#endif
   /* Are we shrinking the file?  Or extending it? */
 
   oldsize = ff->ff_size;
@@ -2333,6 +2696,11 @@ static int fat_unbind(FAR void *handle, FAR struct inode **blkdriver,
       FAR struct inode *inode = fs->fs_blkdriver;
       if (inode)
         {
+          /* Write back and forget the sectors in the buffer cache */
+
+          bcache_flush(inode);
+          bcache_invalidate(inode);
+
           if (inode->u.i_bops && inode->u.i_bops->close)
             {
               inode->u.i_bops->close(inode);
@@ -2358,6 +2726,10 @@ static int fat_unbind(FAR void *handle, FAR struct inode **blkdriver,
       fat_io_free(fs->fs_buffer, fs->fs_hwsectorsize);
     }
 
+#ifdef CONFIG_FAT_FREE_BITMAP
+  fat_freemapdiscard(fs);
+#endif
+
   nxmutex_destroy(&fs->fs_lock);
   fs_heap_free(fs);
   return OK;
@@ -3092,6 +3464,56 @@ errout_with_lock:
   return ret;
 }
 
+/****************************************************************************
+ * Name: fat_syncfs
+ *
+ * Description: Write the buffers of the open files, the sector cache and
+ *   the FSINFO sector to the media, then write back the buffer cache.
+ *
+ ****************************************************************************/
+
+static int fat_syncfs(FAR struct inode *mountpt)
+{
+  FAR struct fat_mountpt_s *fs;
+  FAR struct fat_file_s *ff;
+  int ret;
+
+  DEBUGASSERT(mountpt && mountpt->i_private);
+
+  fs = mountpt->i_private;
+
+  ret = nxmutex_lock(&fs->fs_lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ret = fat_checkmount(fs);
+  if (ret != OK)
+    {
+      goto errout_with_lock;
+    }
+
+  for (ff = fs->fs_head; ff != NULL; ff = ff->ff_next)
+    {
+      ret = fat_ffcacheflush(fs, ff);
+      if (ret < 0)
+        {
+          goto errout_with_lock;
+        }
+    }
+
+  ret = fat_updatefsinfo(fs);
+  if (ret >= 0)
+    {
+      ret = bcache_flush(fs->fs_blkdriver);
+    }
+
+errout_with_lock:
+  nxmutex_unlock(&fs->fs_lock);
+  return ret;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -891,7 +891,27 @@ struct fat_mountpt_s
   uint8_t  fs_fatsecperclus;       /* MBR: Sectors per allocation unit: 2**n, n=0..7 */
   uint8_t *fs_buffer;              /* This is an allocated buffer to hold one
                                     * sector from the device */
+#ifdef CONFIG_FAT_EXTENT_CACHE
+  uint32_t fs_chaingen;            /* Bumped whenever a cluster is released */
+#endif
+#ifdef CONFIG_FAT_FREE_BITMAP
+  FAR uint32_t *fs_freemap;        /* One bit per cluster, set if free */
+#endif
+};
+
+#ifdef CONFIG_FAT_EXTENT_CACHE
+/* This structure describes one run of physically contiguous clusters of a
+ * file:  File clusters fe_index .. fe_index + fe_length - 1 live in disk
+ * clusters fe_cluster .. fe_cluster + fe_length - 1.
+ */
+
+struct fat_extent_s
+{
+  uint32_t fe_index;               /* First file cluster index of the run */
+  uint32_t fe_cluster;             /* Disk cluster holding fe_index */
+  uint32_t fe_length;              /* Number of clusters in the run */
 };
+#endif
 
 /* This structure represents on open file under the mountpoint.  An instance
  * of this structure is retained as struct file specific information on each
@@ -913,6 +933,18 @@ struct fat_file_s
   off_t    ff_cachesector;         /* Current sector in the file buffer */
   off_t    ff_pos;                 /* Current position in the file */
   uint8_t *ff_buffer;              /* File buffer (for partial sector accesses) */
+#ifdef CONFIG_FAT_RWBUFFER
+  uint16_t ff_rwnsectors;          /* Readahead: sectors held in buffer */
+  uint32_t ff_rwbytes;             /* Write-behind: bytes held in buffer */
+  off_t    ff_rwsector;            /* First sector held in ff_rwbuffer */
+  off_t    ff_rdnext;              /* Where a sequential read continues */
+  uint8_t *ff_rwbuffer;            /* Readahead / write-behind buffer */
+#endif
+#ifdef CONFIG_FAT_EXTENT_CACHE
+  uint8_t  ff_nextents;            /* Number of valid entries in ff_extents */
+  uint32_t ff_extentgen;           /* fs_chaingen when extents recorded */
+  struct fat_extent_s ff_extents[CONFIG_FAT_EXTENT_CACHE_NEXTENTS];
+#endif
 };
 
 /* This structure holds the sequence of directory entries used by one
@@ -1055,6 +1087,20 @@ EXTERN int32_t fat_extendchain(FAR struct fat_mountpt_s *fs,
 
 #define fat_createchain(fs) fat_extendchain(fs, 0)
 
+#ifdef CONFIG_FAT_EXTENT_CACHE
+EXTERN int    fat_extentlookup(FAR struct fat_mountpt_s *fs,
+                               FAR struct fat_file_s *ff, uint32_t index,
+                               FAR uint32_t *pindex,
+                               FAR uint32_t *pcluster);
+EXTERN void   fat_extentadd(FAR struct fat_mountpt_s *fs,
+                            FAR struct fat_file_s *ff, uint32_t index,
+                            uint32_t cluster);
+#endif
+
+#ifdef CONFIG_FAT_FREE_BITMAP
+EXTERN void   fat_freemapdiscard(FAR struct fat_mountpt_s *fs);
+#endif
+
 /* Help for traversing directory trees and accessing directory entries */
 
 EXTERN int    fat_nextdirentry(FAR struct fat_mountpt_s *fs,
@@ -1099,6 +1145,12 @@ EXTERN int    fat_ffcacheread(FAR struct fat_mountpt_s *fs,
                               FAR struct fat_file_s *ff, off_t sector);
 EXTERN int    fat_ffcacheinvalidate(FAR struct fat_mountpt_s *fs,
                                     FAR struct fat_file_s *ff);
+#ifdef CONFIG_FAT_RWBUFFER
+EXTERN int    fat_ffrwflush(FAR struct fat_mountpt_s *fs,
+                            FAR struct fat_file_s *ff);
+EXTERN int    fat_ffrwinvalidate(FAR struct fat_mountpt_s *fs,
+                                 FAR struct fat_file_s *ff);
+#endif
 
 /* FSINFO sector support */
 
@@ -32,6 +32,7 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
 #include <time.h>
 #include <assert.h>
 #include <errno.h>
@@ -39,11 +40,24 @@
 
 #include <nuttx/kmalloc.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/bcache.h>
 #include <nuttx/fs/fat.h>
 
 #include "inode/inode.h"
 #include "fs_fat32.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_FAT_FREE_BITMAP
+/* Number of 32-bit words in the free cluster bitmap.  Bit n describes
+ * cluster n + 2.
+ */
+
+#  define FAT_FREEMAP_NWORDS(fs) (((fs)->fs_nclusters + 31) / 32)
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -270,6 +284,150 @@ static int fat_checkbootrecord(struct fat_mountpt_s *fs)
   return OK;
 }
 
+/****************************************************************************
+ * Name: fat_freemapmark
+ *
+ * Description:
+ *   Record in the free cluster bitmap whether 'cluster' is free.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FAT_FREE_BITMAP
+static inline void fat_freemapmark(FAR struct fat_mountpt_s *fs,
+                                   uint32_t cluster, bool isfree)
+{
+  uint32_t bit = cluster - 2;
+
+  if (isfree)
+    {
+      fs->fs_freemap[bit >> 5] |= (uint32_t)1 << (bit & 31);
+    }
+  else
+    {
+      fs->fs_freemap[bit >> 5] &= ~((uint32_t)1 << (bit & 31));
+    }
+}
+
+/****************************************************************************
+ * Name: fat_freemapfind
+ *
+ * Description:
+ *   Search the free cluster bitmap for the first free cluster following
+ *   'startcluster', wrapping around at the end of the volume.
+ *
+ * Returned Value:
+ *   The free cluster number, or zero if there is no free cluster.
+ *
+ ****************************************************************************/
+
+static uint32_t fat_freemapfind(FAR struct fat_mountpt_s *fs,
+                                uint32_t startcluster)
+{
+  uint32_t nwords = FAT_FREEMAP_NWORDS(fs);
+  uint32_t bit;
+  uint32_t word;
+  uint32_t mask;
+  uint32_t bits;
+  uint32_t n;
+
+  /* Bit 'startcluster - 1' describes the cluster after startcluster */
+
+  bit = startcluster - 1;
+  if (startcluster < 1 || bit >= fs->fs_nclusters)
+    {
+      bit = 0;
+    }
+
+  word = bit >> 5;
+  mask = UINT32_MAX << (bit & 31);
+
+  /* The last pass revisits the first word to cover the bits below 'bit' */
+
+  for (n = 0; n <= nwords; n++)
+    {
+      bits = fs->fs_freemap[word] & mask;
+      if (bits != 0)
+        {
+          return (word << 5) + ffs((int)bits) - 1 + 2;
+        }
+
+      mask = UINT32_MAX;
+      if (++word >= nwords)
+        {
+          word = 0;
+        }
+    }
+
+  return 0;
+}
+
+/****************************************************************************
+ * Name: fat_freemapcount
+ *
+ * Description:
+ *   Count the free clusters recorded in the free cluster bitmap.
+ *
+ ****************************************************************************/
+
+static uint32_t fat_freemapcount(FAR struct fat_mountpt_s *fs)
+{
+  uint32_t nwords = FAT_FREEMAP_NWORDS(fs);
+  uint32_t nfree = 0;
+  uint32_t i;
+
+  for (i = 0; i < nwords; i++)
+    {
+      nfree += popcount(fs->fs_freemap[i]);
+    }
+
+  return nfree;
+}
+#endif
+
+/****************************************************************************
+ * Name: fat_extentsearch
+ *
+ * Description:
+ *   Return the number of cached extents whose first file cluster index is
+ *   less than or equal to 'index'.  The extent covering 'index', if any,
+ *   is the one before that position.  The cached extents are discarded
+ *   first if any cluster was released since they were recorded.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FAT_EXTENT_CACHE
+static unsigned int fat_extentsearch(FAR struct fat_mountpt_s *fs,
+                                     FAR struct fat_file_s *ff,
+                                     uint32_t index)
+{
+  unsigned int lo = 0;
+  unsigned int hi;
+  unsigned int mid;
+
+  if (ff->ff_extentgen != fs->fs_chaingen)
+    {
+      ff->ff_extentgen = fs->fs_chaingen;
+      ff->ff_nextents  = 0;
+    }
+
+  hi = ff->ff_nextents;
+  while (lo < hi)
+    {
+      mid = (lo + hi) / 2;
+      if (ff->ff_extents[mid].fe_index <= index)
+        {
+          lo = mid + 1;
+        }
+      else
+        {
+          hi = mid;
+        }
+    }
+
+  return lo;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -703,7 +861,18 @@ int fat_checkmount(struct fat_mountpt_s *fs)
             }
         }
 
-      /* If we get here, the mount is NOT healthy */
+      /* If we get here, the mount is NOT healthy.  The cached sectors are
+       * those of the previous media.
+       */
+
+      if (fs->fs_blkdriver)
+        {
+          bcache_invalidate(fs->fs_blkdriver);
+        }
+
+#ifdef CONFIG_FAT_FREE_BITMAP
+      fat_freemapdiscard(fs);
+#endif
 
       fs->fs_mounted = false;
     }
@@ -728,8 +897,8 @@ int fat_hwread(struct fat_mountpt_s *fs, uint8_t *buffer,  off_t sector,
       struct inode *inode = fs->fs_blkdriver;
       if (inode && inode->u.i_bops && inode->u.i_bops->read)
         {
-          ssize_t nsectorsread = inode->u.i_bops->read(inode, buffer,
-                                                       sector, nsectors);
+          ssize_t nsectorsread = bcache_read(inode, buffer, sector,
+                                             nsectors, fs->fs_hwsectorsize);
           if (nsectorsread == nsectors)
             {
               ret = OK;
@@ -762,7 +931,8 @@ int fat_hwwrite(struct fat_mountpt_s *fs, uint8_t *buffer, off_t sector,
       if (inode && inode->u.i_bops && inode->u.i_bops->write)
         {
           ssize_t nsectorswritten =
-              inode->u.i_bops->write(inode, buffer, sector, nsectors);
+              bcache_write(inode, buffer, sector, nsectors,
+                           fs->fs_hwsectorsize);
 
           if (nsectorswritten == nsectors)
             {
@@ -1103,6 +1273,28 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
       /* Mark the modified sector as "dirty" and return success */
 
       fs->fs_dirty = true;
+
+      if (clusterno >= 2)
+        {
+#ifdef CONFIG_FAT_EXTENT_CACHE
+          /* A released cluster may be reused by any file, so the cached
+           * extents of all open files can no longer be trusted.
+           */
+
+          if (nextcluster == 0)
+            {
+              fs->fs_chaingen++;
+            }
+#endif
+
+#ifdef CONFIG_FAT_FREE_BITMAP
+          if (fs->fs_freemap != NULL)
+            {
+              fat_freemapmark(fs, clusterno, nextcluster == 0);
+            }
+#endif
+        }
+
       return OK;
     }
 
@@ -1226,6 +1418,28 @@ int32_t fat_extendchain(struct fat_mountpt_s *fs, uint32_t cluster)
       startcluster = cluster;
     }
 
+#ifdef CONFIG_FAT_FREE_BITMAP
+  /* Build the free cluster bitmap on first use.  If that is not possible,
+   * fall back to searching the FAT itself.
+   */
+
+  if (fs->fs_freemap == NULL)
+    {
+      fat_computefreeclusters(fs);
+    }
+
+  if (fs->fs_freemap != NULL)
+    {
+      newcluster = fat_freemapfind(fs, startcluster);
+      if (newcluster == 0)
+        {
+          return 0;
+        }
+
+      goto found;
+    }
+#endif
+
   /* Loop until (1) we discover that there are not free clusters
    * (return 0), an errors occurs (return -errno), or (3) we find
    * the next cluster (return the new cluster number).
@@ -1288,6 +1502,9 @@ int32_t fat_extendchain(struct fat_mountpt_s *fs, uint32_t cluster)
    * number in 'newcluster'  Now mark that cluster as in-use.
    */
 
+#ifdef CONFIG_FAT_FREE_BITMAP
+found:
+#endif
   ret = fat_putcluster(fs, newcluster, 0x0fffffff);
   if (ret < 0)
     {
@@ -1323,6 +1540,128 @@ int32_t fat_extendchain(struct fat_mountpt_s *fs, uint32_t cluster)
   return newcluster;
 }
 
+/****************************************************************************
+ * Name: fat_extentlookup
+ *
+ * Description:
+ *   Find the cached file cluster closest to, but not beyond, file cluster
+ *   'index'.
+ *
+ * Input Parameters:
+ *   fs       - The mountpoint holding the file
+ *   ff       - The open file
+ *   index    - The zero-based file cluster index being sought
+ *   pindex   - Location to return the file cluster index that was found
+ *   pcluster - Location to return the disk cluster holding *pindex
+ *
+ * Returned Value:
+ *   OK if a cached cluster was found; -ENOENT if nothing useful is cached.
+ *
+ * Assumptions:
+ *   The caller holds the mountpoint semaphore.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FAT_EXTENT_CACHE
+int fat_extentlookup(FAR struct fat_mountpt_s *fs,
+                     FAR struct fat_file_s *ff, uint32_t index,
+                     FAR uint32_t *pindex, FAR uint32_t *pcluster)
+{
+  FAR struct fat_extent_s *ext;
+  unsigned int pos;
+  uint32_t offset;
+
+  pos = fat_extentsearch(fs, ff, index);
+  if (pos == 0)
+    {
+      return -ENOENT;
+    }
+
+  ext    = &ff->ff_extents[pos - 1];
+  offset = index - ext->fe_index;
+  if (offset >= ext->fe_length)
+    {
+      offset = ext->fe_length - 1;
+    }
+
+  *pindex   = ext->fe_index + offset;
+  *pcluster = ext->fe_cluster + offset;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_extentadd
+ *
+ * Description:
+ *   Record that file cluster 'index' lives in disk cluster 'cluster',
+ *   growing an existing extent when the two are physically contiguous.
+ *
+ * Assumptions:
+ *   The caller holds the mountpoint semaphore.
+ *
+ ****************************************************************************/
+
+void fat_extentadd(FAR struct fat_mountpt_s *fs, FAR struct fat_file_s *ff,
+                   uint32_t index, uint32_t cluster)
+{
+  FAR struct fat_extent_s *ext;
+  unsigned int pos;
+
+  pos = fat_extentsearch(fs, ff, index);
+  if (pos > 0)
+    {
+      ext = &ff->ff_extents[pos - 1];
+      if (index < ext->fe_index + ext->fe_length)
+        {
+          /* Already known */
+
+          return;
+        }
+
+      if (index == ext->fe_index + ext->fe_length &&
+          cluster == ext->fe_cluster + ext->fe_length)
+        {
+          ext->fe_length++;
+
+          /* Merge with the following extent if the two now touch */
+
+          if (pos < ff->ff_nextents &&
+              ext[1].fe_index == index + 1 &&
+              ext[1].fe_cluster == cluster + 1)
+            {
+              ext->fe_length += ext[1].fe_length;
+              ff->ff_nextents--;
+              memmove(&ext[1], &ext[2],
+                      (ff->ff_nextents - pos) * sizeof(*ext));
+            }
+
+          return;
+        }
+    }
+
+  /* Start a new extent at 'pos'.  When the cache is full, give up the
+   * extent covering the highest file offset.
+   */
+
+  if (ff->ff_nextents >= CONFIG_FAT_EXTENT_CACHE_NEXTENTS)
+    {
+      ff->ff_nextents--;
+      if (pos > ff->ff_nextents)
+        {
+          pos = ff->ff_nextents;
+        }
+    }
+
+  ext = &ff->ff_extents[pos];
+  memmove(&ext[1], ext, (ff->ff_nextents - pos) * sizeof(*ext));
+
+  ext->fe_index   = index;
+  ext->fe_cluster = cluster;
+  ext->fe_length  = 1;
+  ff->ff_nextents++;
+}
+#endif
+
 /****************************************************************************
  * Name: fat_nextdirentry
  *
@@ -1870,6 +2209,16 @@ int fat_ffcacheflush(struct fat_mountpt_s *fs, struct fat_file_s *ff)
 {
   int ret;
 
+#ifdef CONFIG_FAT_RWBUFFER
+  /* Write back any appended data held back in the write-behind buffer */
+
+  ret = fat_ffrwflush(fs, ff);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+#endif
   /* Check if the ff_buffer is dirty.  In this case, we will write back the
    * contents of ff_buffer.
    */
@@ -1954,6 +2303,16 @@ int fat_ffcacheinvalidate(struct fat_mountpt_s *fs, struct fat_file_s *ff)
 {
   int ret;
 
+#ifdef CONFIG_FAT_RWBUFFER
+  /* Sectors in the write-behind buffer must reach the media first */
+
+  ret = fat_ffrwflush(fs, ff);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+#endif
   /* Is there anything valid in the buffer now? */
 
   if ((ff->ff_bflags & FFBUFF_VALID) != 0)
@@ -1975,6 +2334,70 @@ int fat_ffcacheinvalidate(struct fat_mountpt_s *fs, struct fat_file_s *ff)
   return OK;
 }
 
+#ifdef CONFIG_FAT_RWBUFFER
+/****************************************************************************
+ * Name: fat_ffrwflush
+ *
+ * Description:
+ *   Write the appended data held in the write-behind buffer to the media
+ *   in a single transfer.  Readahead contents are left in place.
+ *
+ ****************************************************************************/
+
+int fat_ffrwflush(struct fat_mountpt_s *fs, struct fat_file_s *ff)
+{
+  unsigned int nsectors;
+  unsigned int tail;
+  int ret;
+
+  if (ff->ff_rwbytes == 0)
+    {
+      return OK;
+    }
+
+  /* The rest of the last sector lies beyond the end of the file */
+
+  tail = ff->ff_rwbytes & SEC_NDXMASK(fs);
+  if (tail != 0)
+    {
+      memset(&ff->ff_rwbuffer[ff->ff_rwbytes], 0,
+             fs->fs_hwsectorsize - tail);
+    }
+
+  nsectors = SEC_NSECTORS(fs, ff->ff_rwbytes + SEC_NDXMASK(fs));
+  ret = fat_hwwrite(fs, ff->ff_rwbuffer, ff->ff_rwsector, nsectors);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ff->ff_rwbytes = 0;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_ffrwinvalidate
+ *
+ * Description:
+ *   Write back the write-behind buffer and forget any readahead contents.
+ *
+ ****************************************************************************/
+
+int fat_ffrwinvalidate(struct fat_mountpt_s *fs, struct fat_file_s *ff)
+{
+  int ret;
+
+  ret = fat_ffrwflush(fs, ff);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ff->ff_rwnsectors = 0;
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: fat_updatefsinfo
  *
@@ -2029,7 +2452,9 @@ int fat_updatefsinfo(struct fat_mountpt_s *fs)
  * Name: fat_computefreeclusters
  *
  * Description:
- *   Compute the number of free clusters from scratch
+ *   Compute the number of free clusters from scratch.  With
+ *   CONFIG_FAT_FREE_BITMAP, this pass over the FAT also builds the free
+ *   cluster bitmap, after which the count comes from the bitmap.
  *
  ****************************************************************************/
 
@@ -2038,37 +2463,62 @@ int fat_computefreeclusters(struct fat_mountpt_s *fs)
   /* We have to count the number of free clusters */
 
   uint32_t nfreeclusters = 0;
+
+#ifdef CONFIG_FAT_FREE_BITMAP
+  if (fs->fs_freemap != NULL)
+    {
+      nfreeclusters = fat_freemapcount(fs);
+      goto out;
+    }
+
+  /* Failure to allocate the bitmap just means we only count */
+
+  fs->fs_freemap = fs_heap_zalloc(FAT_FREEMAP_NWORDS(fs) *
+                                  sizeof(uint32_t));
+#endif
+
   if (fs->fs_type == FSTYPE_FAT12)
     {
-      off_t sector;
+      uint32_t cluster;
 
-      /* Examine every cluster in the fat */
+      /* Examine every cluster in the fat, the data clusters are numbered
+       * from 2 to fs_nclusters + 1 as in the FAT16/32 case below.
+       */
 
-      for (sector = 2; sector < fs->fs_nclusters + 2; sector++)
+      for (cluster = 2; cluster < fs->fs_nclusters + 2; cluster++)
         {
           /* If the cluster is unassigned, then increment the count of free
            * clusters
            */
 
-          if ((uint16_t)fat_getcluster(fs, sector) == 0)
+          if ((uint16_t)fat_getcluster(fs, cluster) == 0)
             {
               nfreeclusters++;
+#ifdef CONFIG_FAT_FREE_BITMAP
+              if (fs->fs_freemap != NULL)
+                {
+                  fat_freemapmark(fs, cluster, true);
+                }
+#endif
             }
         }
     }
   else
     {
-      unsigned int cluster;
+      uint32_t     cluster;
       off_t        fatsector;
       unsigned int offset;
+      uint32_t     entry;
       int          ret;
 
       fatsector    = fs->fs_fatbase;
       offset       = fs->fs_hwsectorsize;
 
-      /* Examine each cluster in the fat */
+      /* Examine each FAT entry, including the two reserved entries at the
+       * start of the FAT which are never free.
+       */
 
-      for (cluster = fs->fs_nclusters; cluster > 0; cluster--)
+      for (cluster = 0; cluster < fs->fs_nclusters + 2; cluster++)
         {
           /* If we are starting a new sector, then read the new sector in
            * fs_buffer
@@ -2079,6 +2529,9 @@ int fat_computefreeclusters(struct fat_mountpt_s *fs)
               ret = fat_fscacheread(fs, fatsector);
               if (ret < 0)
                 {
+#ifdef CONFIG_FAT_FREE_BITMAP
+                  fat_freemapdiscard(fs);
+#endif
                   return ret;
                 }
 
@@ -2096,25 +2549,31 @@ int fat_computefreeclusters(struct fat_mountpt_s *fs)
 
           if (fs->fs_type == FSTYPE_FAT16)
             {
-              if (FAT_GETFAT16(fs->fs_buffer, offset) == 0)
-                {
-                  nfreeclusters++;
-                }
-
+              entry   = FAT_GETFAT16(fs->fs_buffer, offset);
               offset += 2;
             }
           else
             {
-              if (FAT_GETFAT32(fs->fs_buffer, offset) == 0)
+              entry   = FAT_GETFAT32(fs->fs_buffer, offset) & 0x0fffffff;
+              offset += 4;
+            }
+
+          if (entry == 0 && cluster >= 2)
+            {
+              nfreeclusters++;
+#ifdef CONFIG_FAT_FREE_BITMAP
+              if (fs->fs_freemap != NULL)
                 {
-                  nfreeclusters++;
+                  fat_freemapmark(fs, cluster, true);
                 }
-
-              offset += 4;
+#endif
             }
         }
     }
 
+#ifdef CONFIG_FAT_FREE_BITMAP
+out:
+#endif
   fs->fs_fsifreecount = nfreeclusters;
   if (fs->fs_type == FSTYPE_FAT32)
     {
@@ -2124,6 +2583,26 @@ int fat_computefreeclusters(struct fat_mountpt_s *fs)
   return OK;
 }
 
+/****************************************************************************
+ * Name: fat_freemapdiscard
+ *
+ * Description:
+ *   Release the free cluster bitmap.  It will be rebuilt from the FAT the
+ *   next time it is needed.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FAT_FREE_BITMAP
+void fat_freemapdiscard(FAR struct fat_mountpt_s *fs)
+{
+  if (fs->fs_freemap != NULL)
+    {
+      fs_heap_free(fs->fs_freemap);
+      fs->fs_freemap = NULL;
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: fat_nfreeclusters
  *
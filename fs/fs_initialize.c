@@ -25,6 +25,7 @@
  ****************************************************************************/
 
 #include <nuttx/config.h>
+#include <nuttx/fs/bcache.h>
 #include <nuttx/reboot_notifier.h>
 #include <nuttx/trace.h>
 
@@ -91,6 +92,10 @@ void fs_initialize(void)
 
   file_initlk();
 
+  /* Initialize the block buffer cache */
+
+  bcache_initialize();
+
 #ifdef CONFIG_FS_AIO
   /* Initialize for asynchronous I/O */
 
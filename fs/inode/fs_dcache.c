@@ -0,0 +1,246 @@
+/****************************************************************************
+ * fs/inode/fs_dcache.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <nuttx/spinlock.h>
+
+#include "inode/inode.h"
+
+#ifdef CONFIG_FS_DCACHE
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One cached result of looking up a name among the children of 'parent'.
+ * Only the inode tree is cached.  Below a mountpoint, the file system
+ * resolves the rest of the path in each of its methods (open, stat,
+ * opendir...) and returns no per-name handle, so there is nothing to keep
+ * here.  Caching the outcome of those methods (missing names, stat
+ * results) would need invalidation from every VFS entry point that
+ * creates, removes, renames or modifies a file, and would still be wrong
+ * for volumes that change behind the VFS (remote file systems, media
+ * change).
+ *
+ * A NULL 'node' records that the name does not exist.  'peer' is the
+ * sibling to the left of where the name is (or would be) in the ordered
+ * list, as returned by inode_search().
+ */
+
+struct inode_dentry_s
+{
+  FAR struct inode *parent;      /* Directory searched (NULL: top level) */
+  FAR struct inode *node;        /* Inode found, NULL if not present */
+  FAR struct inode *peer;        /* Inode to the "left" of the name */
+  uint32_t hash;                 /* Hash of the name */
+  uint32_t gen;                  /* g_dcache_gen when the entry was made */
+  uint8_t  namelen;              /* Length of the name */
+  char     name[CONFIG_FS_DCACHE_NAMELEN];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct inode_dentry_s g_dcache[CONFIG_FS_DCACHE_NENTRIES];
+static spinlock_t g_dcache_lock;
+
+/* Entries made under an older generation are stale.  Zero is never a valid
+ * generation so that the initially empty table never matches.
+ */
+
+static uint32_t g_dcache_gen = 1;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inode_dcache_hash
+ *
+ * Description:
+ *   Hash the path segment at 'name' (up to the next '/' or the end of the
+ *   string) and return its length in 'len'.
+ *
+ ****************************************************************************/
+
+static uint32_t inode_dcache_hash(FAR const char *name, FAR size_t *len)
+{
+  FAR const char *ptr = name;
+  uint32_t hash = 2166136261u;
+
+  while (*ptr != '\0' && *ptr != '/')
+    {
+      hash = (hash ^ (uint8_t)*ptr++) * 16777619u;
+    }
+
+  *len = ptr - name;
+  return hash;
+}
+
+/****************************************************************************
+ * Name: inode_dcache_slot
+ ****************************************************************************/
+
+static FAR struct inode_dentry_s *
+inode_dcache_slot(FAR struct inode *parent, uint32_t hash)
+{
+  uint32_t key = hash ^ (uint32_t)((uintptr_t)parent >> 4);
+
+  return &g_dcache[(key * 2654435761u >> 8) % CONFIG_FS_DCACHE_NENTRIES];
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inode_dcache_lookup
+ *
+ * Description:
+ *   Look up the path segment at 'name' among the children of 'parent' in
+ *   the dentry cache.
+ *
+ * Input Parameters:
+ *   parent - The directory inode (NULL for the top level of the tree)
+ *   name   - The path segment, terminated by '/' or the end of the string
+ *   node   - Location to return the inode, NULL if the name is known not
+ *            to exist
+ *   peer   - Location to return the inode to the "left" of the name
+ *
+ * Returned Value:
+ *   true on a cache hit; false if the tree must be searched.
+ *
+ * Assumptions:
+ *   The caller holds the inode tree lock (for reading or writing).
+ *
+ ****************************************************************************/
+
+bool inode_dcache_lookup(FAR struct inode *parent, FAR const char *name,
+                         FAR struct inode **node, FAR struct inode **peer)
+{
+  FAR struct inode_dentry_s *dentry;
+  irqstate_t flags;
+  uint32_t hash;
+  size_t len;
+  bool hit = false;
+
+  hash = inode_dcache_hash(name, &len);
+  if (len > CONFIG_FS_DCACHE_NAMELEN)
+    {
+      return false;
+    }
+
+  dentry = inode_dcache_slot(parent, hash);
+
+  flags = spin_lock_irqsave(&g_dcache_lock);
+  if (dentry->gen == g_dcache_gen && dentry->parent == parent &&
+      dentry->hash == hash && dentry->namelen == len &&
+      memcmp(dentry->name, name, len) == 0)
+    {
+      *node = dentry->node;
+      *peer = dentry->peer;
+      hit   = true;
+    }
+
+  spin_unlock_irqrestore(&g_dcache_lock, flags);
+  return hit;
+}
+
+/****************************************************************************
+ * Name: inode_dcache_add
+ *
+ * Description:
+ *   Remember the result of searching the children of 'parent' for the path
+ *   segment at 'name', replacing whatever shared its slot.
+ *
+ * Assumptions:
+ *   The caller holds the inode tree lock (for reading or writing).
+ *
+ ****************************************************************************/
+
+void inode_dcache_add(FAR struct inode *parent, FAR const char *name,
+                      FAR struct inode *node, FAR struct inode *peer)
+{
+  FAR struct inode_dentry_s *dentry;
+  irqstate_t flags;
+  uint32_t hash;
+  size_t len;
+
+  hash = inode_dcache_hash(name, &len);
+  if (len > CONFIG_FS_DCACHE_NAMELEN)
+    {
+      return;
+    }
+
+  dentry = inode_dcache_slot(parent, hash);
+
+  flags = spin_lock_irqsave(&g_dcache_lock);
+  dentry->parent  = parent;
+  dentry->node    = node;
+  dentry->peer    = peer;
+  dentry->hash    = hash;
+  dentry->gen     = g_dcache_gen;
+  dentry->namelen = len;
+  memcpy(dentry->name, name, len);
+  spin_unlock_irqrestore(&g_dcache_lock, flags);
+}
+
+/****************************************************************************
+ * Name: inode_dcache_invalidate
+ *
+ * Description:
+ *   Forget every cached lookup.  Called whenever an inode is linked into
+ *   or unlinked from the tree, which covers creation, unlink, rename and
+ *   mount/umount.
+ *
+ * Assumptions:
+ *   The caller holds the inode tree lock for writing.
+ *
+ ****************************************************************************/
+
+void inode_dcache_invalidate(void)
+{
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&g_dcache_lock);
+  if (++g_dcache_gen == 0)
+    {
+      /* Wrapped around.  Make sure no old entry can match again. */
+
+      memset(g_dcache, 0, sizeof(g_dcache));
+      g_dcache_gen = 1;
+    }
+
+  spin_unlock_irqrestore(&g_dcache_lock, flags);
+}
+
+#endif /* CONFIG_FS_DCACHE */
@@ -37,6 +37,7 @@
 #include <stdio.h>
 
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/bcache.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/cancelpt.h>
 #include <nuttx/fs/ioctl.h>
@@ -1013,4 +1014,8 @@ int fdlist_close(FAR struct fdlist *list, int fd)
 void sync(void)
 {
   nxsched_foreach(task_fssync, NULL);
+
+  /* Then write back what is left in the buffer cache */
+
+  bcache_flush(NULL);
 }
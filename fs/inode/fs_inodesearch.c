@@ -242,7 +242,35 @@ static int _inode_search(FAR struct inode_search_s *desc)
 
   while (inode != NULL)
     {
-      int result = _inode_compare(name, inode);
+      int result;
+
+#ifdef CONFIG_FS_DCACHE
+      FAR struct inode *node;
+      bool cached = false;
+
+      /* At the head of a list of peers, try the dentry cache before
+       * walking the list.
+       */
+
+      if (left == NULL && inode_dcache_lookup(above, name, &node, &left))
+        {
+          if (node == NULL)
+            {
+              /* The name is known not to exist at this level */
+
+              inode = NULL;
+              break;
+            }
+
+          inode  = node;
+          result = 0;
+          cached = true;
+        }
+      else
+#endif
+        {
+          result = _inode_compare(name, inode);
+        }
 
       /* Case 1:  The name is less than the name of the node.
        * Since the names are ordered, these means that there
@@ -252,6 +280,7 @@ static int _inode_search(FAR struct inode_search_s *desc)
 
       if (result < 0)
         {
+          inode_dcache_add(above, name, NULL, left);
           inode = NULL;
           break;
         }
@@ -267,6 +296,15 @@ static int _inode_search(FAR struct inode_search_s *desc)
 
           left  = inode;
           inode = inode->i_peer;
+
+#ifdef CONFIG_FS_DCACHE
+          if (inode == NULL)
+            {
+              /* Went past the final peer */
+
+              inode_dcache_add(above, name, NULL, left);
+            }
+#endif
         }
 
       /* The names match */
@@ -280,13 +318,22 @@ static int _inode_search(FAR struct inode_search_s *desc)
            *       below this one
            */
 
+#ifdef CONFIG_FS_DCACHE
+          if (!cached)
+            {
+              inode_dcache_add(above, name, inode, left);
+            }
+#endif
+
           name = inode_nextname(name);
           if (*name == '\0' || INODE_IS_MOUNTPT(inode))
             {
               /* Either (1) we are at the end of the path, so this must be
                * the node we are looking for or else (2) this node is a
                * mountpoint and will handle the remaining part of the
-               * pathname
+               * pathname.  The dentry cache stops at a mountpoint too:
+               * the file system gives back no per-name object for the
+               * rest of the path that could be cached.
                */
 
               relpath = name;
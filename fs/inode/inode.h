@@ -237,6 +237,30 @@ void inode_runlock(void);
 
 int inode_search(FAR struct inode_search_s *desc);
 
+/****************************************************************************
+ * Name: inode_dcache_lookup, inode_dcache_add, and inode_dcache_invalidate
+ *
+ * Description:
+ *   Cache of the results of looking up one path segment among the children
+ *   of an inode, used by inode_search().  Any insertion into or removal
+ *   from the inode tree must call inode_dcache_invalidate().
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_DCACHE
+bool inode_dcache_lookup(FAR struct inode *parent, FAR const char *name,
+                         FAR struct inode **node, FAR struct inode **peer);
+void inode_dcache_add(FAR struct inode *parent, FAR const char *name,
+                      FAR struct inode *node, FAR struct inode *peer);
+void inode_dcache_invalidate(void);
+#else
+#  define inode_dcache_add(parent, name, node, peer)
+#  define inode_dcache_invalidate()
+#endif
+
 /****************************************************************************
  * Name: inode_find
  *
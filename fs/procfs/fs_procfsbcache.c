@@ -0,0 +1,292 @@
+/****************************************************************************
+ * fs/procfs/fs_procfsbcache.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/bcache.h>
+#include <nuttx/fs/procfs.h>
+
+#include "fs_heap.h"
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_FS_BCACHE) && !defined(CONFIG_FS_PROCFS_EXCLUDE_BCACHE)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.
+ */
+
+#define BCACHEINFO_LINELEN 80
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct bcacheinfo_file_s
+{
+  struct procfs_file_s base;      /* Base open file structure */
+  unsigned int linesize;          /* Number of valid characters in line[] */
+  char line[BCACHEINFO_LINELEN];  /* Buffer for formatted lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     bcacheinfo_open(FAR struct file *filep,
+                 FAR const char *relpath, int oflags, mode_t mode);
+static int     bcacheinfo_close(FAR struct file *filep);
+static ssize_t bcacheinfo_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     bcacheinfo_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     bcacheinfo_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations g_bcacheinfo_operations =
+{
+  bcacheinfo_open,   /* open */
+  bcacheinfo_close,  /* close */
+  bcacheinfo_read,   /* read */
+  NULL,              /* write */
+  NULL,              /* poll */
+  bcacheinfo_dup,    /* dup */
+  NULL,              /* opendir */
+  NULL,              /* closedir */
+  NULL,              /* readdir */
+  NULL,              /* rewinddir */
+  bcacheinfo_stat    /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: bcacheinfo_open
+ ****************************************************************************/
+
+static int bcacheinfo_open(FAR struct file *filep, FAR const char *relpath,
+                           int oflags, mode_t mode)
+{
+  FAR struct bcacheinfo_file_s *procfile;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   *
+   * REVISIT:  Write-able proc files could be quite useful.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  procfile = (FAR struct bcacheinfo_file_s *)
+    fs_heap_zalloc(sizeof(struct bcacheinfo_file_s));
+  if (!procfile)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)procfile;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bcacheinfo_close
+ ****************************************************************************/
+
+static int bcacheinfo_close(FAR struct file *filep)
+{
+  FAR struct bcacheinfo_file_s *procfile;
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = (FAR struct bcacheinfo_file_s *)filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  /* Release the file attributes structure */
+
+  fs_heap_free(procfile);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bcacheinfo_read
+ ****************************************************************************/
+
+static ssize_t bcacheinfo_read(FAR struct file *filep, FAR char *buffer,
+                               size_t buflen)
+{
+  FAR struct bcacheinfo_file_s *bcfile;
+  struct bcache_stats_s stats;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  DEBUGASSERT(buffer != NULL && buflen > 0);
+  offset = filep->f_pos;
+
+  /* Recover our private data from the struct file instance */
+
+  bcfile = (FAR struct bcacheinfo_file_s *)filep->f_priv;
+  DEBUGASSERT(bcfile);
+
+  /* The first line is the headers */
+
+  linesize  = procfs_snprintf(bcfile->line, BCACHEINFO_LINELEN,
+                              "%10s%10s%10s%10s%11s\n",
+                              "nblocks", "ndirty", "hits", "misses",
+                              "writebacks");
+
+  copysize  = procfs_memcpy(bcfile->line, linesize, buffer, buflen,
+                            &offset);
+  totalsize = copysize;
+
+  buffer   += copysize;
+  buflen   -= copysize;
+
+  /* The second line is the usage statistics */
+
+  bcache_getstats(&stats);
+  linesize   = procfs_snprintf(bcfile->line, BCACHEINFO_LINELEN,
+                               "%10" PRIu32 "%10" PRIu32 "%10" PRIu32
+                               "%10" PRIu32 "%11" PRIu32 "\n",
+                               stats.nblocks, stats.ndirty, stats.hits,
+                               stats.misses, stats.writebacks);
+
+  copysize   = procfs_memcpy(bcfile->line, linesize, buffer, buflen,
+                             &offset);
+  totalsize += copysize;
+
+  /* Update the file offset */
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: bcacheinfo_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int bcacheinfo_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct bcacheinfo_file_s *oldattr;
+  FAR struct bcacheinfo_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct bcacheinfo_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = (FAR struct bcacheinfo_file_s *)
+    fs_heap_malloc(sizeof(struct bcacheinfo_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct bcacheinfo_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bcacheinfo_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int bcacheinfo_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "fs/bcache" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * CONFIG_FS_BCACHE && !CONFIG_FS_PROCFS_EXCLUDE_BCACHE */
@@ -41,6 +41,7 @@
 
 #include <nuttx/kmalloc.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/bcache.h>
 #include <nuttx/fs/ioctl.h>
 
 #include "fs_romfs.h"
@@ -1295,6 +1296,14 @@ static int romfs_unbind(FAR void *handle, FAR struct inode **blkdriver,
           FAR struct inode *inode = rm->rm_blkdriver;
           if (inode)
             {
+              if (INODE_IS_BLOCK(inode))
+                {
+                  /* Forget the sectors in the buffer cache */
+
+                  bcache_flush(inode);
+                  bcache_invalidate(inode);
+                }
+
               if (INODE_IS_BLOCK(inode) && inode->u.i_bops->close != NULL)
                 {
                   inode->u.i_bops->close(inode);
@@ -37,6 +37,7 @@
 #include <debug.h>
 
 #include <nuttx/kmalloc.h>
+#include <nuttx/fs/bcache.h>
 #include <nuttx/fs/ioctl.h>
 
 #include "fs_romfs.h"
@@ -571,7 +572,8 @@ static int romfs_hwwrite(FAR struct romfs_mountpt_s *rm, FAR uint8_t *buffer,
 
   if (inode->u.i_bops->write)
     {
-      ret = inode->u.i_bops->write(inode, buffer, sector, nsectors);
+      ret = bcache_write(inode, buffer, sector, nsectors,
+                         rm->rm_hwsectorsize);
     }
 
   if (ret == (ssize_t)nsectors)
@@ -770,7 +772,7 @@ int romfs_hwread(FAR struct romfs_mountpt_s *rm, FAR uint8_t *buffer,
 
       FAR struct inode *inode = rm->rm_blkdriver;
       ssize_t nsectorsread =
-        inode->u.i_bops->read(inode, buffer, sector, nsectors);
+        bcache_read(inode, buffer, sector, nsectors, rm->rm_hwsectorsize);
 
       if (nsectorsread < 0)
         {
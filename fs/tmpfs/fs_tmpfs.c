@@ -54,8 +54,33 @@
 #  warning CONFIG_FS_TMPFS_DIRECTORY_FREEGUARD needs to be > ALLOCGUARD
 #endif
 
-#if CONFIG_FS_TMPFS_FILE_FREEGUARD <= CONFIG_FS_TMPFS_FILE_ALLOCGUARD
-#  warning CONFIG_FS_TMPFS_FILE_FREEGUARD needs to be > ALLOCGUARD
+#ifdef CONFIG_FS_TMPFS_PAGED
+#  if (CONFIG_FS_TMPFS_PAGESIZE & (CONFIG_FS_TMPFS_PAGESIZE - 1)) != 0
+#    error CONFIG_FS_TMPFS_PAGESIZE must be a power of two
+#  endif
+
+/* File data lives in TMPFS_PAGE_SIZE pages.  Each interior node of the
+ * page tree holds TMPFS_NODE_SLOTS pointers to the level below.  A tree
+ * of height 1 is a single page.
+ */
+
+#  define TMPFS_PAGE_SIZE     CONFIG_FS_TMPFS_PAGESIZE
+#  define TMPFS_NODE_SHIFT    6
+#  define TMPFS_NODE_SLOTS    (1 << TMPFS_NODE_SHIFT)
+#  define TMPFS_NODE_SIZE     (TMPFS_NODE_SLOTS * sizeof(FAR void *))
+
+/* Number of pages covered by a subtree of height 'l' (l >= 1) */
+
+#  define TMPFS_LEVEL_PAGES(l) \
+           ((size_t)1 << (TMPFS_NODE_SHIFT * ((l) - 1)))
+
+#  define tmpfs_free_filedata(tfo) tmpfs_trim_pages(tfo, 0)
+#else
+#  if CONFIG_FS_TMPFS_FILE_FREEGUARD <= CONFIG_FS_TMPFS_FILE_ALLOCGUARD
+#    warning CONFIG_FS_TMPFS_FILE_FREEGUARD needs to be > ALLOCGUARD
+#  endif
+
+#  define tmpfs_free_filedata(tfo) fs_heap_free((tfo)->tfo_data)
 #endif
 
 #define tmpfs_lock(fs) \
@@ -94,6 +119,20 @@ struct tmpfs_dir_s
 
 static int  tmpfs_realloc_directory(FAR struct tmpfs_directory_s *tdo,
               unsigned int nentries);
+#ifdef CONFIG_FS_TMPFS_PAGED
+static void tmpfs_free_subtree(FAR struct tmpfs_file_s *tfo,
+              FAR void *node, unsigned int level);
+static void tmpfs_trim_subtree(FAR struct tmpfs_file_s *tfo,
+              FAR void **slot, unsigned int level, size_t base,
+              size_t first);
+static void tmpfs_trim_pages(FAR struct tmpfs_file_s *tfo, size_t newsize);
+static FAR uint8_t *tmpfs_find_page(FAR struct tmpfs_file_s *tfo,
+              size_t pgno, bool alloc);
+static void tmpfs_read_pages(FAR struct tmpfs_file_s *tfo,
+              FAR char *buffer, size_t pos, size_t nbytes);
+static ssize_t tmpfs_write_pages(FAR struct tmpfs_file_s *tfo,
+              FAR const char *buffer, size_t pos, size_t nbytes);
+#endif
 static int  tmpfs_realloc_file(FAR struct tmpfs_file_s *tfo,
               size_t newsize);
 static void tmpfs_release_lockedobject(FAR struct tmpfs_object_s *to);
@@ -268,10 +307,302 @@ static int tmpfs_realloc_directory(FAR struct tmpfs_directory_s *tdo,
   return ret;
 }
 
+#ifdef CONFIG_FS_TMPFS_PAGED
+/****************************************************************************
+ * Name: tmpfs_free_subtree
+ ****************************************************************************/
+
+static void tmpfs_free_subtree(FAR struct tmpfs_file_s *tfo,
+                               FAR void *node, unsigned int level)
+{
+  FAR void **slots;
+  int i;
+
+  if (level > 1)
+    {
+      slots = node;
+      for (i = 0; i < TMPFS_NODE_SLOTS; i++)
+        {
+          if (slots[i] != NULL)
+            {
+              tmpfs_free_subtree(tfo, slots[i], level - 1);
+            }
+        }
+
+      tfo->tfo_alloc -= TMPFS_NODE_SIZE;
+    }
+  else
+    {
+      tfo->tfo_alloc -= TMPFS_PAGE_SIZE;
+    }
+
+  fs_heap_free(node);
+}
+
+/****************************************************************************
+ * Name: tmpfs_trim_subtree
+ *
+ * Description:
+ *   Free every page at or beyond page 'first' in the subtree at 'slot',
+ *   which has height 'level' and starts at page 'base'.
+ *
+ ****************************************************************************/
+
+static void tmpfs_trim_subtree(FAR struct tmpfs_file_s *tfo,
+                               FAR void **slot, unsigned int level,
+                               size_t base, size_t first)
+{
+  FAR void **slots;
+  size_t span;
+  int i;
+
+  if (*slot == NULL)
+    {
+      return;
+    }
+
+  if (base >= first)
+    {
+      tmpfs_free_subtree(tfo, *slot, level);
+      *slot = NULL;
+      return;
+    }
+
+  if (level == 1)
+    {
+      return;
+    }
+
+  slots = *slot;
+  span  = TMPFS_LEVEL_PAGES(level - 1);
+  for (i = 0; i < TMPFS_NODE_SLOTS; i++, base += span)
+    {
+      if (base + span > first)
+        {
+          tmpfs_trim_subtree(tfo, &slots[i], level - 1, base, first);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: tmpfs_trim_pages
+ *
+ * Description:
+ *   Release the pages that lie entirely beyond 'newsize' and clear the
+ *   tail of the last partial page, so that bytes past the end of the file
+ *   always read as zero if the file grows again.
+ *
+ ****************************************************************************/
+
+static void tmpfs_trim_pages(FAR struct tmpfs_file_s *tfo, size_t newsize)
+{
+  FAR uint8_t *page;
+  size_t offset = newsize % TMPFS_PAGE_SIZE;
+
+  if (tfo->tfo_height > 0)
+    {
+      tmpfs_trim_subtree(tfo, &tfo->tfo_root, tfo->tfo_height, 0,
+                         (newsize + TMPFS_PAGE_SIZE - 1) / TMPFS_PAGE_SIZE);
+    }
+
+  if (tfo->tfo_root == NULL)
+    {
+      tfo->tfo_height = 0;
+    }
+  else if (offset != 0)
+    {
+      page = tmpfs_find_page(tfo, newsize / TMPFS_PAGE_SIZE, false);
+      if (page != NULL)
+        {
+          memset(page + offset, 0, TMPFS_PAGE_SIZE - offset);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: tmpfs_find_page
+ *
+ * Description:
+ *   Return the page holding page number 'pgno' of the file.  If 'alloc' is
+ *   true, the tree is grown and a zeroed page is allocated for a hole;
+ *   otherwise NULL is returned for a hole.  NULL is also returned if
+ *   memory is exhausted.
+ *
+ ****************************************************************************/
+
+static FAR uint8_t *tmpfs_find_page(FAR struct tmpfs_file_s *tfo,
+                                    size_t pgno, bool alloc)
+{
+  FAR void **slot;
+  FAR void **node;
+  unsigned int level;
+
+  /* Add levels on top of the tree until it covers 'pgno' */
+
+  while (tfo->tfo_height == 0 ||
+         pgno >= TMPFS_LEVEL_PAGES(tfo->tfo_height))
+    {
+      if (!alloc)
+        {
+          return NULL;
+        }
+
+      if (tfo->tfo_root != NULL)
+        {
+          node = fs_heap_zalloc(TMPFS_NODE_SIZE);
+          if (node == NULL)
+            {
+              return NULL;
+            }
+
+          node[0]         = tfo->tfo_root;
+          tfo->tfo_root   = node;
+          tfo->tfo_alloc += TMPFS_NODE_SIZE;
+        }
+
+      tfo->tfo_height++;
+    }
+
+  /* Then walk down to the page, filling in missing nodes if asked to */
+
+  slot = &tfo->tfo_root;
+  for (level = tfo->tfo_height; level > 1; level--)
+    {
+      if (*slot == NULL)
+        {
+          if (!alloc)
+            {
+              return NULL;
+            }
+
+          *slot = fs_heap_zalloc(TMPFS_NODE_SIZE);
+          if (*slot == NULL)
+            {
+              return NULL;
+            }
+
+          tfo->tfo_alloc += TMPFS_NODE_SIZE;
+        }
+
+      node = *slot;
+      slot = &node[(pgno >> (TMPFS_NODE_SHIFT * (level - 2))) &
+                   (TMPFS_NODE_SLOTS - 1)];
+    }
+
+  if (*slot == NULL && alloc)
+    {
+      *slot = fs_heap_zalloc(TMPFS_PAGE_SIZE);
+      if (*slot != NULL)
+        {
+          tfo->tfo_alloc += TMPFS_PAGE_SIZE;
+        }
+    }
+
+  return *slot;
+}
+
+/****************************************************************************
+ * Name: tmpfs_read_pages
+ ****************************************************************************/
+
+static void tmpfs_read_pages(FAR struct tmpfs_file_s *tfo,
+                             FAR char *buffer, size_t pos, size_t nbytes)
+{
+  FAR uint8_t *page;
+  size_t offset;
+  size_t ncopy;
+
+  while (nbytes > 0)
+    {
+      offset = pos % TMPFS_PAGE_SIZE;
+      ncopy  = TMPFS_PAGE_SIZE - offset;
+      if (ncopy > nbytes)
+        {
+          ncopy = nbytes;
+        }
+
+      /* Holes read back as zeros */
+
+      page = tmpfs_find_page(tfo, pos / TMPFS_PAGE_SIZE, false);
+      if (page != NULL)
+        {
+          memcpy(buffer, page + offset, ncopy);
+        }
+      else
+        {
+          memset(buffer, 0, ncopy);
+        }
+
+      buffer += ncopy;
+      pos    += ncopy;
+      nbytes -= ncopy;
+    }
+}
+
+/****************************************************************************
+ * Name: tmpfs_write_pages
+ *
+ * Description:
+ *   Copy data into the file pages, allocating pages as needed.  Returns
+ *   the number of bytes written, which is short if memory runs out part
+ *   way, or -ENOMEM if nothing could be written.
+ *
+ ****************************************************************************/
+
+static ssize_t tmpfs_write_pages(FAR struct tmpfs_file_s *tfo,
+                                 FAR const char *buffer, size_t pos,
+                                 size_t nbytes)
+{
+  FAR uint8_t *page;
+  size_t nwritten = 0;
+  size_t offset;
+  size_t ncopy;
+
+  while (nwritten < nbytes)
+    {
+      offset = pos % TMPFS_PAGE_SIZE;
+      ncopy  = TMPFS_PAGE_SIZE - offset;
+      if (ncopy > nbytes - nwritten)
+        {
+          ncopy = nbytes - nwritten;
+        }
+
+      page = tmpfs_find_page(tfo, pos / TMPFS_PAGE_SIZE, true);
+      if (page == NULL)
+        {
+          return nwritten > 0 ? (ssize_t)nwritten : -ENOMEM;
+        }
+
+      memcpy(page + offset, buffer + nwritten, ncopy);
+      pos      += ncopy;
+      nwritten += ncopy;
+    }
+
+  return nwritten;
+}
+#endif
+
 /****************************************************************************
  * Name: tmpfs_realloc_file
  ****************************************************************************/
 
+#ifdef CONFIG_FS_TMPFS_PAGED
+static int tmpfs_realloc_file(FAR struct tmpfs_file_s *tfo,
+                              size_t newsize)
+{
+  /* Growing only moves the end of the file; the new range is a hole until
+   * it is written.
+   */
+
+  if (newsize < tfo->tfo_size)
+    {
+      tmpfs_trim_pages(tfo, newsize);
+    }
+
+  tfo->tfo_size = newsize;
+  return OK;
+}
+#else
 static int tmpfs_realloc_file(FAR struct tmpfs_file_s *tfo,
                               size_t newsize)
 {
@@ -345,6 +676,7 @@ static int tmpfs_realloc_file(FAR struct tmpfs_file_s *tfo,
   tfo->tfo_data  = newdata;
   return OK;
 }
+#endif
 
 /****************************************************************************
  * Name: tmpfs_release_lockedobject
@@ -383,7 +715,7 @@ static void tmpfs_release_lockedfile(FAR struct tmpfs_file_s *tfo)
     {
       tmpfs_unlock_file(tfo);
       nxrmutex_destroy(&tfo->tfo_lock);
-      fs_heap_free(tfo->tfo_data);
+      tmpfs_free_filedata(tfo);
       fs_heap_free(tfo);
     }
 
@@ -582,7 +914,12 @@ tmpfs_alloc_file(FAR struct tmpfs_directory_s *parent)
   tfo->tfo_parent = parent;
   tfo->tfo_flags  = 0;
   tfo->tfo_size   = 0;
+#ifdef CONFIG_FS_TMPFS_PAGED
+  tfo->tfo_height = 0;
+  tfo->tfo_root   = NULL;
+#else
   tfo->tfo_data   = NULL;
+#endif
 
   nxrmutex_init(&tfo->tfo_lock);
   tmpfs_lock_file(tfo);
@@ -1189,7 +1526,16 @@ static int tmpfs_statfs_callout(FAR struct tmpfs_directory_s *tdo,
 
       tmptfo             = (FAR struct tmpfs_file_s *)to;
       tmpbuf->tsf_alloc += sizeof(struct tmpfs_file_s);
+#ifdef CONFIG_FS_TMPFS_PAGED
+      /* Holes make the file larger than the memory it holds */
+
+      if (to->to_alloc > tmptfo->tfo_size)
+        {
+          tmpbuf->tsf_avail += to->to_alloc - tmptfo->tfo_size;
+        }
+#else
       tmpbuf->tsf_avail += to->to_alloc - tmptfo->tfo_size;
+#endif
       tmpbuf->tsf_files++;
     }
   else /* if (to->to_type == TMPFS_DIRECTORY) */
@@ -1265,7 +1611,7 @@ static int tmpfs_free_callout(FAR struct tmpfs_directory_s *tdo,
           return TMPFS_UNLINKED;
         }
 
-      fs_heap_free(tfo->tfo_data);
+      tmpfs_free_filedata(tfo);
     }
   else /* if (to->to_type == TMPFS_DIRECTORY) */
     {
@@ -1586,6 +1932,10 @@ static ssize_t tmpfs_read(FAR struct file *filep, FAR char *buffer,
 
   /* Copy data from the memory object to the user buffer */
 
+#ifdef CONFIG_FS_TMPFS_PAGED
+  tmpfs_read_pages(tfo, buffer, startpos, nread);
+  filep->f_pos += nread;
+#else
   if (tfo->tfo_data != NULL)
     {
       memcpy(buffer, &tfo->tfo_data[startpos], nread);
@@ -1595,6 +1945,7 @@ static ssize_t tmpfs_read(FAR struct file *filep, FAR char *buffer,
     {
       DEBUGASSERT(tfo->tfo_size == 0 && nread == 0);
     }
+#endif
 
   /* Release the lock on the file */
 
@@ -1642,6 +1993,22 @@ static ssize_t tmpfs_write(FAR struct file *filep, FAR const char *buffer,
       startpos = filep->f_pos;
     }
 
+#ifdef CONFIG_FS_TMPFS_PAGED
+  /* Fill the pages first; the file only grows by what was written */
+
+  nwritten = tmpfs_write_pages(tfo, buffer, startpos, buflen);
+  if (nwritten < 0)
+    {
+      ret = nwritten;
+      goto errout_with_lock;
+    }
+
+  endpos = startpos + nwritten;
+  if (endpos > tfo->tfo_size)
+    {
+      tfo->tfo_size = endpos;
+    }
+#else
   nwritten = buflen;
   endpos   = startpos + buflen;
 
@@ -1666,6 +2033,7 @@ static ssize_t tmpfs_write(FAR struct file *filep, FAR const char *buffer,
     {
       DEBUGASSERT(tfo->tfo_size == 0 && nwritten == 0);
     }
+#endif
 
   filep->f_pos = endpos;
 
@@ -1788,7 +2156,32 @@ static int tmpfs_mmap(FAR struct file *filep, FAR struct mm_map_entry_s *map)
   if (map->offset >= 0 && map->offset < tfo->tfo_size &&
       map->length && map->offset + map->length <= tfo->tfo_size)
     {
+#ifdef CONFIG_FS_TMPFS_PAGED
+      FAR uint8_t *page;
+
+      /* Only a range within one page is contiguous in memory.  Let
+       * mmap() fall back to a copy for anything larger.
+       */
+
+      if (map->offset / TMPFS_PAGE_SIZE !=
+          (map->offset + map->length - 1) / TMPFS_PAGE_SIZE)
+        {
+          return -ENOTTY;
+        }
+
+      tmpfs_lock_file(tfo);
+      page = tmpfs_find_page(tfo, map->offset / TMPFS_PAGE_SIZE, true);
+      tmpfs_unlock_file(tfo);
+
+      if (page == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      map->vaddr = page + map->offset % TMPFS_PAGE_SIZE;
+#else
       map->vaddr = tfo->tfo_data + map->offset;
+#endif
       map->priv.p = tfo;
       map->munmap = tmpfs_unmap;
       ret = mm_map_add(get_current_mm(), map);
@@ -1842,7 +2235,32 @@ static int tmpfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
     {
       FAR uintptr_t *ptr = (FAR uintptr_t *)arg;
 
+#ifdef CONFIG_FS_TMPFS_PAGED
+      FAR uint8_t *page = NULL;
+
+      /* Only a file that fits in one page is contiguous in memory */
+
+      if (tfo->tfo_size > TMPFS_PAGE_SIZE)
+        {
+          return -ENOTTY;
+        }
+
+      if (tfo->tfo_size > 0)
+        {
+          tmpfs_lock_file(tfo);
+          page = tmpfs_find_page(tfo, 0, true);
+          tmpfs_unlock_file(tfo);
+
+          if (page == NULL)
+            {
+              return -ENOMEM;
+            }
+        }
+
+      *ptr = (uintptr_t)page;
+#else
       *ptr = (uintptr_t)tfo->tfo_data;
+#endif
       return OK;
     }
 
@@ -1976,14 +2394,16 @@ static int tmpfs_truncate(FAR struct file *filep, off_t length)
           goto errout_with_lock;
         }
 
+#ifndef CONFIG_FS_TMPFS_PAGED
       /* If the size has increased, then we need to zero the newly added
-       * memory.
+       * memory.  (With paged storage the new range is a hole.)
        */
 
       if (length > oldsize)
         {
           memset(&tfo->tfo_data[oldsize], 0, length - oldsize);
         }
+#endif
 
       ret = OK;
     }
@@ -2426,7 +2846,7 @@ static int tmpfs_unlink(FAR struct inode *mountpt, FAR const char *relpath)
   else
     {
       nxrmutex_destroy(&tfo->tfo_lock);
-      fs_heap_free(tfo->tfo_data);
+      tmpfs_free_filedata(tfo);
       fs_heap_free(tfo);
     }
 
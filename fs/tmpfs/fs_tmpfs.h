@@ -128,7 +128,12 @@ struct tmpfs_file_s
 
   uint8_t       tfo_flags; /* See TFO_FLAG_* definitions */
   size_t        tfo_size;  /* Valid file size */
+#ifdef CONFIG_FS_TMPFS_PAGED
+  uint8_t       tfo_height; /* Levels in the page tree, 0 if empty */
+  FAR void     *tfo_root;  /* Page tree root; holes are NULL */
+#else
   FAR uint8_t  *tfo_data;  /* File data starts here */
+#endif
 };
 
 /* This structure represents one instance of a TMPFS file system */
@@ -27,11 +27,15 @@
 #include <nuttx/config.h>
 
 #include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <sys/statfs.h>
+#include <string.h>
 #include <stdbool.h>
 #include <errno.h>
 #include <debug.h>
 
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/net/net.h>
 #include "fs_heap.h"
@@ -40,6 +44,79 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: xipfile
+ *
+ * Description:
+ *   Transfer a file whose data is directly addressable in memory (XIP
+ *   ROMFS): the data is written from where it lives, without going
+ *   through an intermediate buffer.
+ *
+ * Returned Value:
+ *   The number of bytes transferred, a negated errno value on failure, or
+ *   -ENOSYS if the input file is not addressable in memory.
+ *
+ ****************************************************************************/
+
+static ssize_t xipfile(FAR struct file *outfile, FAR struct file *infile,
+                       FAR off_t *offset, size_t count)
+{
+  FAR const uint8_t *data;
+  size_t ntransferred = 0;
+  ssize_t nbyteswritten;
+  off_t pos;
+
+  pos = offset ? *offset : file_seek(infile, 0, SEEK_CUR);
+  if (pos < 0)
+    {
+      return -ENOSYS;
+    }
+
+  data = file_xipdata(infile, pos, count);
+  if (data == NULL)
+    {
+      return -ENOSYS;
+    }
+
+  while (ntransferred < count)
+    {
+      nbyteswritten = file_write(outfile, data + ntransferred,
+                                 count - ntransferred);
+      if (nbyteswritten < 0)
+        {
+          /* EINTR is not an error once some data was transferred (but
+           * will still stop the copy), as in copyfile().
+           */
+
+          if (nbyteswritten != -EINTR || ntransferred == 0)
+            {
+              return nbyteswritten;
+            }
+
+          break;
+        }
+
+      ntransferred += nbyteswritten;
+    }
+
+  /* Update the position as if the data had been read */
+
+  if (offset)
+    {
+      *offset = pos + ntransferred;
+    }
+  else
+    {
+      pos = file_seek(infile, pos + ntransferred, SEEK_SET);
+      if (pos < 0)
+        {
+          return pos;
+        }
+    }
+
+  return ntransferred;
+}
+
 static ssize_t copyfile(FAR struct file *outfile, FAR struct file *infile,
                         FAR off_t *offset, size_t count)
 {
@@ -237,6 +314,60 @@ static ssize_t copyfile(FAR struct file *outfile, FAR struct file *infile,
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: file_xipdata
+ *
+ * Description:
+ *   Return the address of 'count' bytes at 'offset' of the file if they
+ *   can be used in place for as long as the file system is mounted.
+ *
+ *   Only XIP ROMFS qualifies: its data lives in the memory of the backing
+ *   device and can never change.  tmpfs also reports FIOC_XIPBASE, but its
+ *   file data is reallocated by writes and freed by truncate or unlink,
+ *   possibly while packets still reference it.
+ *
+ * Returned Value:
+ *   The address of the data, or NULL if it must be read.
+ *
+ ****************************************************************************/
+
+FAR const void *file_xipdata(FAR struct file *filep, off_t offset,
+                             size_t count)
+{
+#ifndef CONFIG_DISABLE_MOUNTPOINT
+  FAR struct inode *inode = filep->f_inode;
+  struct statfs sfs;
+  uintptr_t xipbase;
+  struct stat st;
+
+  if (!INODE_IS_MOUNTPT(inode) || inode->u.i_mops == NULL ||
+      inode->u.i_mops->statfs == NULL)
+    {
+      return NULL;
+    }
+
+  memset(&sfs, 0, sizeof(struct statfs));
+  if (inode->u.i_mops->statfs(inode, &sfs) < 0 ||
+      sfs.f_type != ROMFS_MAGIC ||
+      file_ioctl(filep, FIOC_XIPBASE, (unsigned long)&xipbase) < 0 ||
+      file_fstat(filep, &st) < 0)
+    {
+      return NULL;
+    }
+
+  /* A short file is left to the file system to handle */
+
+  if (offset < 0 || offset > st.st_size || count > st.st_size - offset)
+    {
+      return NULL;
+    }
+
+  return (FAR const uint8_t *)xipbase + offset;
+#else
+  return NULL;
+#endif
+}
+
 /****************************************************************************
  * Name: file_sendfile
  *
@@ -249,6 +380,8 @@ static ssize_t copyfile(FAR struct file *outfile, FAR struct file *infile,
 ssize_t file_sendfile(FAR struct file *outfile, FAR struct file *infile,
                       FAR off_t *offset, size_t count)
 {
+  ssize_t ret;
+
   if (count == 0)
     {
       nwarn("WARNING: sendfile count is zero\n");
@@ -267,7 +400,7 @@ ssize_t file_sendfile(FAR struct file *outfile, FAR struct file *infile,
     {
       /* Then let psock_sendfile do the work. */
 
-      int ret = psock_sendfile(psock, infile, offset, count);
+      ret = psock_sendfile(psock, infile, offset, count);
       if (ret >= 0 || ret != -ENOSYS)
         {
           return ret;
@@ -279,10 +412,17 @@ ssize_t file_sendfile(FAR struct file *outfile, FAR struct file *infile,
     }
 #endif
 
-  /* No... then this is probably a file-to-file transfer.  The generic
-   * copyfile() can handle that case.
+  /* No... then this is probably a file-to-file transfer.  Write the data
+   * directly from memory if the file system allows it, otherwise the
+   * generic copyfile() can handle that case.
    */
 
+  ret = xipfile(outfile, infile, offset, count);
+  if (ret != -ENOSYS)
+    {
+      return ret;
+    }
+
   return copyfile(outfile, infile, offset, count);
 }
 
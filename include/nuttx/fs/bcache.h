@@ -0,0 +1,196 @@
+/****************************************************************************
+ * include/nuttx/fs/bcache.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_FS_BCACHE_H
+#define __INCLUDE_NUTTX_FS_BCACHE_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+
+#include <nuttx/fs/fs.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Without the buffer cache, the sectors are transferred directly with the
+ * block driver.
+ */
+
+#ifndef CONFIG_FS_BCACHE
+#  define bcache_initialize()
+#  define bcache_read(inode, buffer, start, nsectors, sectsize) \
+     ((inode)->u.i_bops->read(inode, buffer, start, nsectors))
+#  define bcache_write(inode, buffer, start, nsectors, sectsize) \
+     ((inode)->u.i_bops->write(inode, buffer, start, nsectors))
+#  define bcache_flush(inode) ((void)(inode), OK)
+#  define bcache_invalidate(inode)
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_BCACHE
+/* Buffer cache statistics, as shown in /proc/fs/bcache */
+
+struct bcache_stats_s
+{
+  uint32_t nblocks;     /* Number of sectors held in the cache */
+  uint32_t ndirty;      /* Number of them not yet written back */
+  uint32_t hits;        /* Sectors found in the cache */
+  uint32_t misses;      /* Sectors read from the block drivers */
+  uint32_t writebacks;  /* Dirty sectors written to the block drivers */
+};
+#endif
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+#ifdef CONFIG_FS_BCACHE
+
+/****************************************************************************
+ * Name: bcache_initialize
+ *
+ * Description:
+ *   Initialize the buffer cache.  Called once by fs_initialize().
+ *
+ ****************************************************************************/
+
+void bcache_initialize(void);
+
+/****************************************************************************
+ * Name: bcache_read
+ *
+ * Description:
+ *   Read sectors of a block driver through the buffer cache.  Single
+ *   sectors are served from and kept in the cache.  Larger transfers are
+ *   read from the block driver directly, the sectors not yet written back
+ *   are then copied over the data read.
+ *
+ * Input Parameters:
+ *   inode    - The block driver
+ *   buffer   - The location to return the data
+ *   start    - The first sector to read
+ *   nsectors - The number of sectors to read
+ *   sectsize - The size of one sector of the block driver
+ *
+ * Returned Value:
+ *   The number of sectors read, or a negated errno value, as the read
+ *   method of the block driver.
+ *
+ ****************************************************************************/
+
+ssize_t bcache_read(FAR struct inode *inode, FAR unsigned char *buffer,
+                    blkcnt_t start, unsigned int nsectors,
+                    blksize_t sectsize);
+
+/****************************************************************************
+ * Name: bcache_write
+ *
+ * Description:
+ *   Write sectors of a block driver through the buffer cache.  Single
+ *   sectors are kept in the cache and written back later by the flusher
+ *   work.  Larger transfers are written to the block driver directly and
+ *   update the sectors that are cached.
+ *
+ * Input Parameters:
+ *   inode    - The block driver
+ *   buffer   - The data to write
+ *   start    - The first sector to write
+ *   nsectors - The number of sectors to write
+ *   sectsize - The size of one sector of the block driver
+ *
+ * Returned Value:
+ *   The number of sectors written, or a negated errno value, as the write
+ *   method of the block driver.
+ *
+ ****************************************************************************/
+
+ssize_t bcache_write(FAR struct inode *inode,
+                     FAR const unsigned char *buffer, blkcnt_t start,
+                     unsigned int nsectors, blksize_t sectsize);
+
+/****************************************************************************
+ * Name: bcache_flush
+ *
+ * Description:
+ *   Write back the dirty sectors of a block driver.
+ *
+ * Input Parameters:
+ *   inode - The block driver, or NULL to write back all block drivers
+ *
+ * Returned Value:
+ *   Zero on success, or the negated errno value of the first failure.
+ *
+ ****************************************************************************/
+
+int bcache_flush(FAR struct inode *inode);
+
+/****************************************************************************
+ * Name: bcache_invalidate
+ *
+ * Description:
+ *   Drop all the sectors of a block driver from the cache, the dirty ones
+ *   included.  Called after bcache_flush() before the block driver is
+ *   closed.
+ *
+ * Input Parameters:
+ *   inode - The block driver
+ *
+ ****************************************************************************/
+
+void bcache_invalidate(FAR struct inode *inode);
+
+/****************************************************************************
+ * Name: bcache_getstats
+ *
+ * Description:
+ *   Get the statistics of the buffer cache.
+ *
+ ****************************************************************************/
+
+void bcache_getstats(FAR struct bcache_stats_s *stats);
+
+#endif /* CONFIG_FS_BCACHE */
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_NUTTX_FS_BCACHE_H */
@@ -1626,6 +1626,24 @@ ssize_t file_pwrite(FAR struct file *filep, FAR const void *buf,
 ssize_t file_sendfile(FAR struct file *outfile, FAR struct file *infile,
                       FAR off_t *offset, size_t count);
 
+/****************************************************************************
+ * Name: file_xipdata
+ *
+ * Description:
+ *   Return the address of 'count' bytes at 'offset' of the file if they
+ *   can be used in place for as long as the file system is mounted.  This
+ *   is only the case for XIP ROMFS, whose data can never change or move.
+ *   The data of writable file systems such as tmpfs may be reallocated or
+ *   freed at any time and must be read through the file system.
+ *
+ * Returned Value:
+ *   The address of the data, or NULL if it must be read.
+ *
+ ****************************************************************************/
+
+FAR const void *file_xipdata(FAR struct file *filep, off_t offset,
+                             size_t count);
+
 /****************************************************************************
  * Name: file_seek
  *
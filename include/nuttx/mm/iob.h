@@ -102,6 +102,11 @@
 
 typedef CODE void (*iob_free_cb_t)(FAR void *data);
 
+/* Copies 'len' bytes from 'src' to 'dest' for iob_copyin_func() */
+
+typedef CODE void (*iob_copy_t)(FAR void *arg, FAR uint8_t *dest,
+                                FAR const uint8_t *src, unsigned int len);
+
 /* Represents one I/O buffer.  A packet is contained by one or more I/O
  * buffers in a chain.  The io_pktlen is only valid for the I/O buffer at
  * the head of the chain.
@@ -127,6 +132,17 @@ struct iob_s
 #endif
   unsigned int io_pktlen; /* Total length of the packet */
 
+#ifdef CONFIG_NETDEV_OFFLOAD
+  /* Offload metadata of a network packet, only valid in the head of the
+   * chain.  See the NETPKT_* flags in include/nuttx/net/netdev.h.
+   */
+
+  uint8_t  io_offload;    /* NETPKT_* offload flags */
+  uint8_t  io_csumoff;    /* Offset of the checksum from io_csumstart */
+  uint16_t io_csumstart;  /* Start of the checksummed data from L3 */
+  uint16_t io_gsosize;    /* Size of the payload of each segment */
+#endif
+
 #ifdef CONFIG_IOB_ALLOC
   iob_free_cb_t io_free;  /* Custom free callback */
   FAR uint8_t  *io_data;
@@ -476,6 +492,32 @@ int iob_copyin(FAR struct iob_s *iob, FAR const uint8_t *src,
 int iob_trycopyin(FAR struct iob_s *iob, FAR const uint8_t *src,
                   unsigned int len, int offset, bool throttled);
 
+/****************************************************************************
+ * Name: iob_copyin_func
+ *
+ * Description:
+ *  Like iob_copyin() BUT the data is copied by calling 'copy' for each
+ *  I/O buffer, so that the caller can process the data in the same pass.
+ *
+ ****************************************************************************/
+
+int iob_copyin_func(FAR struct iob_s *iob, FAR const uint8_t *src,
+                    unsigned int len, int offset, bool throttled,
+                    iob_copy_t copy, FAR void *arg);
+
+/****************************************************************************
+ * Name: iob_trycopyin_func
+ *
+ * Description:
+ *  Like iob_copyin_func() BUT without waiting if buffers are not
+ *  available.
+ *
+ ****************************************************************************/
+
+int iob_trycopyin_func(FAR struct iob_s *iob, FAR const uint8_t *src,
+                       unsigned int len, int offset, bool throttled,
+                       iob_copy_t copy, FAR void *arg);
+
 /****************************************************************************
  * Name: iob_copyout
  *
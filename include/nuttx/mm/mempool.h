@@ -87,6 +87,22 @@ struct mempool_procfs_entry_s
 };
 #endif
 
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+/* This structure describes the per-CPU cache (magazine) of free blocks
+ * in front of a memory buffer pool.  Its lock is only ever taken by other
+ * CPUs when the pool runs short of blocks, so it is normally uncontended.
+ */
+
+struct mempool_percpu_s
+{
+  spinlock_t     lock;  /* The protect lock of the cache */
+  size_t         count; /* The number of cached free blocks */
+  unsigned long  hit;   /* Allocations served from the cache */
+  unsigned long  miss;  /* Allocations that had to refill the cache */
+  FAR void      *blks[CONFIG_MM_MEMPOOL_PERCPU_SIZE]; /* Cached blocks */
+};
+#endif
+
 /* This structure describes memory buffer pool */
 
 struct mempool_s
@@ -110,6 +126,9 @@ struct mempool_s
   size_t     nalloc;  /* The number of used block in mempool */
   spinlock_t lock;    /* The protect lock to mempool */
   sem_t      waitsem; /* The semaphore of waiter get free block */
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+  struct mempool_percpu_s percpu[CONFIG_SMP_NCPUS]; /* Per-CPU caches */
+#endif
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMPOOL)
   struct mempool_procfs_entry_s procfs; /* The entry of procfs */
 #endif
@@ -0,0 +1,84 @@
+/****************************************************************************
+ * include/nuttx/mm/memprof.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_MM_MEMPROF_H
+#define __INCLUDE_NUTTX_MM_MEMPROF_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stddef.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_MM_MEMPROF
+#  define memprof_alloc(mem, size)
+#  define memprof_free(mem)
+#endif
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+#ifdef CONFIG_MM_MEMPROF
+
+/****************************************************************************
+ * Name: memprof_alloc
+ *
+ * Description:
+ *   Account an allocation in the sampling heap profiler.
+ *
+ ****************************************************************************/
+
+void memprof_alloc(FAR void *mem, size_t size);
+
+/****************************************************************************
+ * Name: memprof_free
+ *
+ * Description:
+ *   Account the release of a block in the sampling heap profiler.
+ *
+ ****************************************************************************/
+
+void memprof_free(FAR void *mem);
+
+#endif
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_NUTTX_MM_MEMPROF_H */
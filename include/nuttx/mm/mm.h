@@ -268,6 +268,13 @@ void umm_initialize(FAR void *heap_start, size_t heap_size);
 void kmm_initialize(FAR void *heap_start, size_t heap_size);
 #endif
 
+/* Functions contained in umm_tcache.c **************************************/
+
+#ifdef CONFIG_MM_TCACHE
+struct tls_info_s;
+void umm_tcache_destroy(FAR struct tls_info_s *info);
+#endif
+
 /* Functions contained in umm_addregion.c ***********************************/
 
 void umm_addregion(FAR void *heapstart, size_t heapsize);
@@ -181,6 +181,15 @@ struct sock_intf_s
                     FAR struct file *infile, FAR off_t *offset,
                     size_t count);
 #endif
+
+  /* Optional batch receive of recvmmsg().  si_recvmmsg only receives the
+   * messages already queued, without waiting.  It returns the number of
+   * messages received or a negated errno value.
+   */
+
+  CODE int        (*si_recvmmsg)(FAR struct socket *psock,
+                    FAR struct mmsghdr *msgvec, unsigned int vlen,
+                    int flags);
 };
 
 /* Each socket refers to a connection structure of type FAR void *.  Each
@@ -234,6 +243,10 @@ struct socket_conn_s
   uint8_t       s_ttl;       /* Default time-to-live */
 #endif
 
+#ifdef CONFIG_NET_CONN_LOCK
+  mutex_t       s_lock;      /* Protects the read-ahead buffers */
+#endif
+
   /* Connection-specific content may follow */
 };
 
@@ -380,6 +393,49 @@ int net_trylock(void);
 
 void net_unlock(void);
 
+/****************************************************************************
+ * Name: conn_lock
+ *
+ * Description:
+ *   Take the lock of one connection.  The lock protects the read-ahead
+ *   buffers of the connection.  It may be taken with or without the
+ *   network lock held, but the network lock must never be taken while
+ *   holding it.
+ *
+ * Input Parameters:
+ *   sconn - The common part of the connection
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_CONN_LOCK
+void conn_lock(FAR struct socket_conn_s *sconn);
+#else
+#  define conn_lock(s)
+#endif
+
+/****************************************************************************
+ * Name: conn_unlock
+ *
+ * Description:
+ *   Release the lock of one connection.
+ *
+ * Input Parameters:
+ *   sconn - The common part of the connection
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_CONN_LOCK
+void conn_unlock(FAR struct socket_conn_s *sconn);
+#else
+#  define conn_unlock(s)
+#endif
+
 /****************************************************************************
  * Name: net_sem_timedwait
  *
@@ -928,6 +984,68 @@ ssize_t psock_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
 ssize_t psock_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
                       int flags);
 
+/****************************************************************************
+ * Name: psock_sendmmsg
+ *
+ * Description:
+ *   psock_sendmmsg() sends several messages on a socket.  This is an
+ *   internal OS interface.  It is functionally equivalent to sendmmsg()
+ *   except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - It accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ * Input Parameters:
+ *   psock     A pointer to a NuttX-specific, internal socket structure
+ *   msgvec    The messages to send
+ *   vlen      The number of messages in msgvec
+ *   flags     Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of messages sent, msg_len of each of
+ *   them holds the number of bytes sent.  If no message could be sent, a
+ *   negated errno value is returned (see comments with sendmsg() for a
+ *   list of appropriate errno values).
+ *
+ ****************************************************************************/
+
+int psock_sendmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags);
+
+/****************************************************************************
+ * Name: psock_recvmmsg
+ *
+ * Description:
+ *   psock_recvmmsg() receives several messages from a socket.  This is an
+ *   internal OS interface.  It is functionally equivalent to recvmmsg()
+ *   except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - It accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ * Input Parameters:
+ *   psock     A pointer to a NuttX-specific, internal socket structure
+ *   msgvec    Buffers to receive the messages
+ *   vlen      The number of messages in msgvec
+ *   flags     Receive flags
+ *   timeout   Time after which no further message is waited for, or NULL
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received, msg_len of each
+ *   of them holds the number of bytes received.  If no message could be
+ *   received, a negated errno value is returned (see comments with
+ *   recvmsg() for a list of appropriate errno values).
+ *
+ ****************************************************************************/
+
+int psock_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags,
+                   FAR struct timespec *timeout);
+
 /****************************************************************************
  * Name: psock_send
  *
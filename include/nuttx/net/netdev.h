@@ -216,6 +216,42 @@
      (netdev_ipv6_lookup(dev, addr, true) != NULL)
 #endif
 
+#ifdef CONFIG_NETDEV_OFFLOAD
+/* Offload features of a device (d_features).  The lower half sets the
+ * first three before registering the device, NETDEV_F_GSO is set by the
+ * upper half if it can handle NETPKT_GSO_* packets for the device.
+ */
+
+#  define NETDEV_F_TXCSUM         (1 << 0) /* TCP/UDP checksum on TX */
+#  define NETDEV_F_RXCSUM         (1 << 1) /* TCP/UDP checksum check on RX */
+#  define NETDEV_F_TSO            (1 << 2) /* TCP segmentation, IPv4/IPv6 */
+#  define NETDEV_F_GSO            (1 << 3) /* Large TCP packets accepted */
+
+/* Offload flags of a packet (io_offload of the head IOB).
+ *
+ * NETPKT_CSUM_PARTIAL: TX only.  The checksum field at io_csumstart +
+ *   io_csumoff holds the sum of the pseudo header, the device has to add
+ *   the data from io_csumstart (relative to L3) to the end of the packet
+ *   and store the complement.
+ * NETPKT_CSUM_VALID: RX only.  The device verified the TCP/UDP checksum.
+ * NETPKT_GSO_TCPV4/6: TX only.  The TCP payload has to be cut into
+ *   segments of io_gsosize bytes.  Implies NETPKT_CSUM_PARTIAL.
+ */
+
+#  define NETPKT_CSUM_PARTIAL     (1 << 0)
+#  define NETPKT_CSUM_VALID       (1 << 1)
+#  define NETPKT_GSO_TCPV4        (1 << 2)
+#  define NETPKT_GSO_TCPV6        (1 << 3)
+#  define NETPKT_GSO_MASK         (NETPKT_GSO_TCPV4 | NETPKT_GSO_TCPV6)
+
+#  define NETDEV_HAS_FEATURE(dev,f) (((dev)->d_features & (f)) != 0)
+#  define NETDEV_RX_CSUM_VALID(dev) \
+     (((dev)->d_iob->io_offload & NETPKT_CSUM_VALID) != 0)
+#else
+#  define NETDEV_HAS_FEATURE(dev,f) false
+#  define NETDEV_RX_CSUM_VALID(dev) false
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -339,6 +375,10 @@ struct net_driver_s
 
   uint16_t d_pktsize;           /* Maximum packet size */
 
+#ifdef CONFIG_NETDEV_OFFLOAD
+  uint32_t d_features;          /* See NETDEV_F_* definitions */
+#endif
+
   /* Link layer address */
 
 #if defined(CONFIG_NET_ETHERNET) || defined(CONFIG_NET_6LOWPAN) || \
@@ -810,6 +850,32 @@ void netdev_carrier_off(FAR struct net_driver_s *dev);
 
 uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len);
 
+/****************************************************************************
+ * Name: chksum_copy
+ *
+ * Description:
+ *   Copy the memory region described by src and len to dest and calculate
+ *   its raw change sum in the same pass.
+ *
+ *   If CONFIG_NET_ARCH_CHKSUM_COPY is defined, then this function must be
+ *   provided by architecture-specific logic.
+ *
+ * Input Parameters:
+ *   sum  - Partial calculations carried over from a previous call.
+ *   dest - Destination of the copy.
+ *   src  - Beginning of the data to copy and include in the checksum.
+ *   len  - Length of the data to copy.
+ *   odd  - In: the previous region ended on an odd byte.  Out: this
+ *          region ends on an odd byte.  Should be false on the first call.
+ *
+ * Returned Value:
+ *   The updated checksum value.
+ *
+ ****************************************************************************/
+
+uint16_t chksum_copy(uint16_t sum, FAR uint8_t *dest,
+                     FAR const uint8_t *src, uint16_t len, FAR bool *odd);
+
 /****************************************************************************
  * Name: chksum_iob
  *
@@ -830,6 +896,46 @@ uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len);
 
 uint16_t chksum_iob(uint16_t sum, FAR struct iob_s *iob, uint16_t offset);
 
+/****************************************************************************
+ * Name: chksum_iob_copyin
+ *
+ * Description:
+ *   Copy data from a user buffer into an iob chain, as iob_copyin() does,
+ *   and calculate the raw change sum of the copied data in the same pass.
+ *
+ * Input Parameters:
+ *   iob       - The iob chain to copy into, extended as necessary.
+ *   src       - The data to copy.
+ *   len       - Length of the data to copy.
+ *   offset    - Offset in the iob chain of the copy.
+ *   throttled - Whether the iob allocations are throttled.
+ *   sum       - In: partial calculations carried over from a previous
+ *               call, should be zero the first time.  Out: the updated
+ *               checksum value.  The data is summed as if it started at
+ *               an even position.
+ *
+ * Returned Value:
+ *   The number of uncopied bytes left if >= 0 OR a negative error code.
+ *
+ ****************************************************************************/
+
+int chksum_iob_copyin(FAR struct iob_s *iob, FAR const uint8_t *src,
+                      unsigned int len, int offset, bool throttled,
+                      FAR uint16_t *sum);
+
+/****************************************************************************
+ * Name: chksum_iob_trycopyin
+ *
+ * Description:
+ *   Like chksum_iob_copyin() BUT without waiting if buffers are not
+ *   available.
+ *
+ ****************************************************************************/
+
+int chksum_iob_trycopyin(FAR struct iob_s *iob, FAR const uint8_t *src,
+                         unsigned int len, int offset, bool throttled,
+                         FAR uint16_t *sum);
+
 /****************************************************************************
  * Name: net_chksum
  *
@@ -1347,4 +1453,30 @@ int netdev_ipv6_foreach(FAR struct net_driver_s *dev,
 void netdev_statistics_log(FAR void *arg);
 #endif
 
+/****************************************************************************
+ * Name: netdev_rss_hash
+ *
+ * Description:
+ *   Calculate the flow hash passed to the driver with SIOCNOTIFYRECVCPU.
+ *   The local address and port come first, so a driver hashing a received
+ *   packet passes its destination as the source.
+ *
+ * Input Parameters:
+ *   domain   - The layer 3 protocol, PF_INET/PF_INET6
+ *   src_addr - The source (local) address, in_addr_t or net_ipv6addr_t
+ *   src_port - The source (local) port
+ *   dst_addr - The destination (remote) address
+ *   dst_port - The destination (remote) port
+ *
+ * Returned Value:
+ *  The hash value
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_RSS
+uint32_t netdev_rss_hash(uint8_t domain,
+                         FAR const void *src_addr, uint16_t src_port,
+                         FAR const void *dst_addr, uint16_t dst_port);
+#endif
+
 #endif /* __INCLUDE_NUTTX_NET_NETDEV_H */
@@ -224,6 +224,10 @@ struct tls_info_s
   uint16_t tl_size;                    /* Actual size with alignments */
   int tl_errno;                        /* Per-thread error number */
   pid_t tl_tid;                        /* Thread ID */
+
+#ifdef CONFIG_MM_TCACHE
+  FAR struct umm_tcache_s *tl_tcache;  /* Per-thread user heap cache */
+#endif
 };
 
 /****************************************************************************
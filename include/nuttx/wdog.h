@@ -97,6 +97,9 @@ struct wdog_s
   FAR void          *picbase;    /* PIC base address */
 #endif
   clock_t            expired;    /* Timer associated with the absolute time */
+#ifdef CONFIG_WDOG_PERCPU
+  uint8_t            cpu;        /* CPU whose queue holds the watchdog */
+#endif
 };
 
 /****************************************************************************
@@ -136,9 +136,13 @@
 #define MSG_ERRQUEUE     0x002000 /* Fetch message from error queue.  */
 #define MSG_NOSIGNAL     0x004000 /* Do not generate SIGPIPE.  */
 #define MSG_MORE         0x008000 /* Sender will send more.  */
+#define MSG_WAITFORONE   0x010000 /* recvmmsg: block for the first message
+                                   * only.
+                                   */
 #define MSG_CMSG_CLOEXEC 0x100000 /* Set close_on_exit for file
                                    * descriptor received through SCM_RIGHTS.
                                    */
+#define MSG_ZEROCOPY     0x4000000 /* Send user data without copying it.  */
 
 /* Protocol levels supported by get/setsockopt(): */
 
@@ -220,6 +224,16 @@
 #define SO_PEERCRED     18 /* Return the credentials of the peer process
                             * connected to this socket.
                             */
+#define SO_REUSEPORT    19 /* Allow several sockets to bind the same local
+                            * address and port (get/set).
+                            * arg: pointer to integer containing a boolean
+                            * value
+                            */
+#define SO_ZEROCOPY     20 /* Allow MSG_ZEROCOPY sends, completions are read
+                            * with MSG_ERRQUEUE (get/set).
+                            * arg: pointer to integer containing a boolean
+                            * value
+                            */
 
 /* The options are unsupported but included for compatibility
  * and portability
@@ -297,6 +311,18 @@
 #define SCM_SECURITY    0x03    /* rw: security label */
 #define SCM_TIMESTAMP   SO_TIMESTAMP
 
+/* Origins and codes of struct sock_extended_err, read from the error
+ * queue with MSG_ERRQUEUE.
+ */
+
+#define SO_EE_ORIGIN_NONE          0
+#define SO_EE_ORIGIN_LOCAL         1
+#define SO_EE_ORIGIN_ICMP          2
+#define SO_EE_ORIGIN_ICMP6         3
+#define SO_EE_ORIGIN_ZEROCOPY      5
+
+#define SO_EE_CODE_ZEROCOPY_COPIED 1 /* The data was copied after all */
+
 /* Desired design of maximum size and alignment (see RFC2553) */
 
 #define SS_MAXSIZE   128               /* Implementation-defined maximum size. */
@@ -372,6 +398,16 @@ struct msghdr
   unsigned int msg_flags;
 };
 
+/* Message of the recvmmsg()/sendmmsg() vectors */
+
+struct mmsghdr
+{
+  struct msghdr msg_hdr;        /* The message */
+  unsigned int msg_len;         /* Number of bytes received or sent */
+};
+
+struct timespec; /* Forward reference */
+
 struct cmsghdr
 {
   unsigned long cmsg_len;       /* Data byte count, including hdr */
@@ -386,6 +422,22 @@ struct ucred
   gid_t gid;
 };
 
+/* Error queue message, the payload of an IP_RECVERR/IPV6_RECVERR control
+ * message.  For SO_EE_ORIGIN_ZEROCOPY, ee_info and ee_data hold the first
+ * and the last completed MSG_ZEROCOPY send call.
+ */
+
+struct sock_extended_err
+{
+  uint32_t ee_errno;            /* Error number */
+  uint8_t  ee_origin;           /* SO_EE_ORIGIN_* */
+  uint8_t  ee_type;
+  uint8_t  ee_code;             /* SO_EE_CODE_* */
+  uint8_t  ee_pad;
+  uint32_t ee_info;
+  uint32_t ee_data;
+};
+
 /****************************************************************************
  * Inline Functions
  ****************************************************************************/
@@ -459,6 +511,11 @@ int getpeername(int sockfd, FAR struct sockaddr *addr,
 ssize_t recvmsg(int sockfd, FAR struct msghdr *msg, int flags);
 ssize_t sendmsg(int sockfd, FAR struct msghdr *msg, int flags);
 
+int recvmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags, FAR struct timespec *timeout);
+int sendmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags);
+
 #if CONFIG_FORTIFY_SOURCE > 0
 fortify_function(send) ssize_t send(int sockfd, FAR const void *buf,
                                     size_t len, int flags)
@@ -49,6 +49,10 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* Maximum number of messages handled by one sendmmsg()/recvmmsg() call */
+
+#define UIO_MAXIOV 1024
+
 #if defined(CONFIG_FS_LARGEFILE)
 #  define preadv64  preadv
 #  define pwritev64 pwritev
@@ -32,6 +32,7 @@
 
 #include <nuttx/pthread.h>
 #include <nuttx/tls.h>
+#include <nuttx/mm/mm.h>
 
 /****************************************************************************
  * Public Functions
@@ -68,6 +69,10 @@ void pthread_exit(FAR void *exit_value)
   tls_destruct();
 #endif
 
+#ifdef CONFIG_MM_TCACHE
+  umm_tcache_destroy(tls_get_info());
+#endif
+
   nx_pthread_exit(exit_value);
   PANIC();
 }
@@ -35,6 +35,7 @@
 
 #include <nuttx/tls.h>
 #include <nuttx/pthread.h>
+#include <nuttx/mm/mm.h>
 
 #if defined(CONFIG_BUILD_FLAT) || !defined(__KERNEL__)
 
@@ -121,6 +122,10 @@ void exit(int status)
   fflush(NULL);
 #endif
 
+#ifdef CONFIG_MM_TCACHE
+  umm_tcache_destroy(tls_get_info());
+#endif
+
   /* Then perform the exit */
 
   _exit(status);
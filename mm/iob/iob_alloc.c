@@ -96,6 +96,9 @@ static FAR struct iob_s *iob_alloc_committed(void)
       iob->io_len    = 0;    /* Length of the data in the entry */
       iob->io_offset = 0;    /* Offset to the beginning of data */
       iob->io_pktlen = 0;    /* Total length of the packet */
+#ifdef CONFIG_NETDEV_OFFLOAD
+      iob->io_offload = 0;   /* No offload metadata */
+#endif
     }
 
   spin_unlock_irqrestore(&g_iob_lock, flags);
@@ -135,6 +138,9 @@ static FAR struct iob_s *iob_tryalloc_internal(bool throttled)
           iob->io_len    = 0;    /* Length of the data in the entry */
           iob->io_offset = 0;    /* Offset to the beginning of data */
           iob->io_pktlen = 0;    /* Total length of the packet */
+#ifdef CONFIG_NETDEV_OFFLOAD
+          iob->io_offload = 0;   /* No offload metadata */
+#endif
           return iob;
         }
     }
@@ -345,6 +351,9 @@ FAR struct iob_s *iob_alloc_dynamic(uint16_t size)
       iob->io_bufsize = size;             /* Total length of the iob buffer */
       iob->io_pktlen  = 0;                /* Total length of the packet */
       iob->io_free    = iob_free_dynamic; /* Customer free callback */
+#ifdef CONFIG_NETDEV_OFFLOAD
+      iob->io_offload = 0;                /* No offload metadata */
+#endif
       iob->io_data    = (FAR uint8_t *)ALIGN_UP((uintptr_t)(iob + 1),
                                                 CONFIG_IOB_ALIGNMENT);
     }
@@ -391,6 +400,9 @@ FAR struct iob_s *iob_alloc_with_data(FAR void *data, uint16_t size,
       iob->io_bufsize = size;    /* Total length of the iob buffer */
       iob->io_pktlen  = 0;       /* Total length of the packet */
       iob->io_free    = free_cb; /* Customer free callback */
+#ifdef CONFIG_NETDEV_OFFLOAD
+      iob->io_offload = 0;       /* No offload metadata */
+#endif
       iob->io_data    = data;
     }
 
@@ -45,7 +45,8 @@
  *
  * Description:
  *  Copy data 'len' bytes from a user buffer into the I/O buffer chain,
- *  starting at 'offset', extending the chain as necessary.
+ *  starting at 'offset', extending the chain as necessary.  The data is
+ *  copied by 'copy' if it is not NULL.
  *
  * Returned Value:
  *  The number of uncopied bytes left if >= 0 OR a negative error code.
@@ -54,7 +55,8 @@
 
 static int iob_copyin_internal(FAR struct iob_s *iob, FAR const uint8_t *src,
                                unsigned int len, int offset,
-                               bool throttled, bool can_block)
+                               bool throttled, bool can_block,
+                               iob_copy_t copy, FAR void *arg)
 {
   FAR struct iob_s *head = iob;
   FAR struct iob_s *next;
@@ -161,7 +163,15 @@ static int iob_copyin_internal(FAR struct iob_s *iob, FAR const uint8_t *src,
 
       /* Copy from the user buffer to the I/O buffer.  */
 
-      memcpy(dest, src, ncopy);
+      if (copy != NULL)
+        {
+          copy(arg, dest, src, ncopy);
+        }
+      else
+        {
+          memcpy(dest, src, ncopy);
+        }
+
       iobinfo("iob=%p Copy %u bytes new len=%u\n",
               iob, ncopy, iob->io_len);
 
@@ -227,7 +237,8 @@ static int iob_copyin_internal(FAR struct iob_s *iob, FAR const uint8_t *src,
 int iob_copyin(FAR struct iob_s *iob, FAR const uint8_t *src,
                unsigned int len, int offset, bool throttled)
 {
-  return iob_copyin_internal(iob, src, len, offset, throttled, true);
+  return iob_copyin_internal(iob, src, len, offset, throttled, true,
+                             NULL, NULL);
 }
 
 /****************************************************************************
@@ -243,5 +254,40 @@ int iob_copyin(FAR struct iob_s *iob, FAR const uint8_t *src,
 int iob_trycopyin(FAR struct iob_s *iob, FAR const uint8_t *src,
                   unsigned int len, int offset, bool throttled)
 {
-  return iob_copyin_internal(iob, src, len, offset, throttled, false);
+  return iob_copyin_internal(iob, src, len, offset, throttled, false,
+                             NULL, NULL);
+}
+
+/****************************************************************************
+ * Name: iob_copyin_func
+ *
+ * Description:
+ *  Like iob_copyin() BUT the data is copied by calling 'copy' for each
+ *  I/O buffer, so that the caller can process the data in the same pass.
+ *
+ ****************************************************************************/
+
+int iob_copyin_func(FAR struct iob_s *iob, FAR const uint8_t *src,
+                    unsigned int len, int offset, bool throttled,
+                    iob_copy_t copy, FAR void *arg)
+{
+  return iob_copyin_internal(iob, src, len, offset, throttled, true,
+                             copy, arg);
+}
+
+/****************************************************************************
+ * Name: iob_trycopyin_func
+ *
+ * Description:
+ *  Like iob_copyin_func() BUT without waiting if buffers are not
+ *  available.
+ *
+ ****************************************************************************/
+
+int iob_trycopyin_func(FAR struct iob_s *iob, FAR const uint8_t *src,
+                       unsigned int len, int offset, bool throttled,
+                       iob_copy_t copy, FAR void *arg)
+{
+  return iob_copyin_internal(iob, src, len, offset, throttled, false,
+                             copy, arg);
 }
@@ -42,6 +42,19 @@
 
 #define MEMPOOL_HEADER_SIZE (sizeof(sq_entry_t) + CONFIG_MM_NODE_GUARDSIZE)
 
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+/* The number of blocks moved between a per-CPU cache and the pool */
+
+#  define MEMPOOL_PERCPU_BATCH (CONFIG_MM_MEMPOOL_PERCPU_SIZE / 2)
+
+/* The waiters of a pool must be woken up by every release, so such pools
+ * bypass the per-CPU caches.
+ */
+
+#  define MEMPOOL_PERCPU_ENABLED(pool) \
+     (!(pool)->wait || (pool)->expandsize != 0)
+#endif
+
 #if CONFIG_MM_BACKTRACE >= 0
 #define MEMPOOL_MAGIC_FREE  0x55555555
 #define MEMPOOL_MAGIC_ALLOC 0xAAAAAAAA
@@ -100,6 +113,170 @@ static inline void mempool_add_queue(FAR struct mempool_s *pool,
     }
 }
 
+static inline bool mempool_in_ibase(FAR struct mempool_s *pool,
+                                    FAR void *blk)
+{
+  size_t blocksize = MEMPOOL_REALBLOCKSIZE(pool);
+
+  return pool->interruptsize > blocksize &&
+         (FAR char *)blk >= pool->ibase &&
+         (FAR char *)blk < pool->ibase + pool->interruptsize - blocksize;
+}
+
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+/****************************************************************************
+ * Name: mempool_percpu_alloc
+ *
+ * Description:
+ *   Take a free block from the cache of the current CPU.  An empty cache
+ *   is refilled with up to MEMPOOL_PERCPU_BATCH blocks from the shared
+ *   queue of the pool under a single acquisition of the pool lock.
+ *
+ *   The cache lock is always taken before the pool lock.
+ *
+ ****************************************************************************/
+
+static FAR sq_entry_t *mempool_percpu_alloc(FAR struct mempool_s *pool)
+{
+  FAR struct mempool_percpu_s *pcpu;
+  FAR sq_entry_t *blk = NULL;
+  irqstate_t flags;
+
+  flags = up_irq_save();
+  pcpu = &pool->percpu[this_cpu()];
+  spin_lock(&pcpu->lock);
+
+  if (pcpu->count == 0)
+    {
+      pcpu->miss++;
+      spin_lock(&pool->lock);
+      while (pcpu->count < MEMPOOL_PERCPU_BATCH)
+        {
+          blk = mempool_remove_queue(pool, &pool->queue);
+          if (blk == NULL)
+            {
+              break;
+            }
+
+          pcpu->blks[pcpu->count++] = blk;
+        }
+
+      pool->nalloc += pcpu->count;
+      spin_unlock(&pool->lock);
+    }
+  else
+    {
+      pcpu->hit++;
+    }
+
+  blk = pcpu->count > 0 ? pcpu->blks[--pcpu->count] : NULL;
+  spin_unlock(&pcpu->lock);
+  up_irq_restore(flags);
+  return blk;
+}
+
+/****************************************************************************
+ * Name: mempool_percpu_release
+ *
+ * Description:
+ *   Put a free block into the cache of the current CPU.  A full cache
+ *   gives MEMPOOL_PERCPU_BATCH blocks back to the shared queue first.
+ *
+ ****************************************************************************/
+
+static void mempool_percpu_release(FAR struct mempool_s *pool,
+                                   FAR void *blk)
+{
+  FAR struct mempool_percpu_s *pcpu;
+  irqstate_t flags;
+
+  flags = up_irq_save();
+  pcpu = &pool->percpu[this_cpu()];
+  spin_lock(&pcpu->lock);
+
+  if (pcpu->count == CONFIG_MM_MEMPOOL_PERCPU_SIZE)
+    {
+      spin_lock(&pool->lock);
+      while (pcpu->count > CONFIG_MM_MEMPOOL_PERCPU_SIZE -
+                           MEMPOOL_PERCPU_BATCH)
+        {
+          sq_addlast(pcpu->blks[--pcpu->count], &pool->queue);
+          pool->nalloc--;
+        }
+
+      spin_unlock(&pool->lock);
+    }
+
+  pcpu->blks[pcpu->count++] = blk;
+  spin_unlock(&pcpu->lock);
+  up_irq_restore(flags);
+}
+
+/****************************************************************************
+ * Name: mempool_percpu_flush
+ *
+ * Description:
+ *   Return the blocks cached by all CPUs to the shared queue of the pool.
+ *   Must not be called with the pool lock held.
+ *
+ * Returned Value:
+ *   The number of blocks returned to the pool.
+ *
+ ****************************************************************************/
+
+static size_t mempool_percpu_flush(FAR struct mempool_s *pool)
+{
+  FAR struct mempool_percpu_s *pcpu;
+  size_t nflush = 0;
+  irqstate_t flags;
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      pcpu = &pool->percpu[cpu];
+      flags = spin_lock_irqsave(&pcpu->lock);
+      if (pcpu->count > 0)
+        {
+          spin_lock(&pool->lock);
+          while (pcpu->count > 0)
+            {
+              sq_addlast(pcpu->blks[--pcpu->count], &pool->queue);
+              pool->nalloc--;
+              nflush++;
+            }
+
+          spin_unlock(&pool->lock);
+        }
+
+      spin_unlock_irqrestore(&pcpu->lock, flags);
+    }
+
+  return nflush;
+}
+
+/****************************************************************************
+ * Name: mempool_percpu_count
+ *
+ * Description:
+ *   Return the number of free blocks held in the per-CPU caches.  The
+ *   result is only a snapshot since the caches are not locked.
+ *
+ ****************************************************************************/
+
+static size_t mempool_percpu_count(FAR struct mempool_s *pool)
+{
+  size_t count = 0;
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      count += pool->percpu[cpu].count;
+    }
+
+  return count;
+}
+#endif
+
 #if CONFIG_MM_BACKTRACE >= 0
 static inline void mempool_add_backtrace(FAR struct mempool_s *pool,
                                          FAR struct mempool_backtrace_s *buf)
@@ -257,6 +434,9 @@ mempool_memdump_free_callback(FAR struct mempool_s *pool,
 int mempool_init(FAR struct mempool_s *pool, FAR const char *name)
 {
   size_t blocksize = MEMPOOL_REALBLOCKSIZE(pool);
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+  int i;
+#endif
 
   sq_init(&pool->queue);
   sq_init(&pool->iqueue);
@@ -313,6 +493,16 @@ int mempool_init(FAR struct mempool_s *pool, FAR const char *name)
       nxsem_init(&pool->waitsem, 0, 0);
     }
 
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
+    {
+      spin_lock_init(&pool->percpu[i].lock);
+      pool->percpu[i].count = 0;
+      pool->percpu[i].hit   = 0;
+      pool->percpu[i].miss  = 0;
+    }
+#endif
+
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMPOOL)
   mempool_procfs_register(&pool->procfs, name);
 #  ifdef CONFIG_MM_BACKTRACE_DEFAULT
@@ -347,11 +537,36 @@ FAR void *mempool_allocate(FAR struct mempool_s *pool)
   FAR sq_entry_t *blk;
   irqstate_t flags;
 
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+  if (MEMPOOL_PERCPU_ENABLED(pool))
+    {
+      blk = mempool_percpu_alloc(pool);
+      if (blk != NULL)
+        {
+          goto out;
+        }
+    }
+#endif
+
 retry:
   flags = spin_lock_irqsave(&pool->lock);
   blk = mempool_remove_queue(pool, &pool->queue);
   if (blk == NULL)
     {
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+      /* Reclaim the blocks cached by the other CPUs before falling back
+       * to the interrupt queue or expanding the pool.
+       */
+
+      spin_unlock_irqrestore(&pool->lock, flags);
+      if (mempool_percpu_flush(pool) > 0)
+        {
+          goto retry;
+        }
+
+      flags = spin_lock_irqsave(&pool->lock);
+#endif
+
       if (up_interrupt_context())
         {
           blk = mempool_remove_queue(pool, &pool->iqueue);
@@ -401,6 +616,9 @@ retry:
   pool->nalloc++;
   spin_unlock_irqrestore(&pool->lock, flags);
 
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+out:
+#endif
 #if CONFIG_MM_BACKTRACE >= 0
   mempool_add_backtrace(pool, (FAR struct mempool_backtrace_s *)
                               ((FAR char *)blk + pool->blocksize));
@@ -427,8 +645,7 @@ retry:
 
 void mempool_release(FAR struct mempool_s *pool, FAR void *blk)
 {
-  irqstate_t flags = spin_lock_irqsave(&pool->lock);
-  size_t blocksize = MEMPOOL_REALBLOCKSIZE(pool);
+  irqstate_t flags;
 #if CONFIG_MM_BACKTRACE >= 0
   FAR struct mempool_backtrace_s *buf =
     (FAR struct mempool_backtrace_s *)((FAR char *)blk + pool->blocksize);
@@ -440,23 +657,25 @@ void mempool_release(FAR struct mempool_s *pool, FAR void *blk)
 
 #endif
 
-  pool->nalloc--;
-
 #ifdef CONFIG_MM_FILL_ALLOCATIONS
   memset(blk, MM_FREE_MAGIC, pool->blocksize);
 #endif
 
-  if (pool->interruptsize > blocksize)
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+  if (MEMPOOL_PERCPU_ENABLED(pool) && !mempool_in_ibase(pool, blk))
     {
-      if ((FAR char *)blk >= pool->ibase &&
-          (FAR char *)blk < pool->ibase + pool->interruptsize - blocksize)
-        {
-          sq_addlast(blk, &pool->iqueue);
-        }
-      else
-        {
-          sq_addlast(blk, &pool->queue);
-        }
+      kasan_poison(blk, pool->blocksize);
+      mempool_percpu_release(pool, blk);
+      return;
+    }
+#endif
+
+  flags = spin_lock_irqsave(&pool->lock);
+  pool->nalloc--;
+
+  if (mempool_in_ibase(pool, blk))
+    {
+      sq_addlast(blk, &pool->iqueue);
     }
   else
     {
@@ -495,6 +714,9 @@ int mempool_info(FAR struct mempool_s *pool, FAR struct mempoolinfo_s *info)
 {
   size_t blocksize = MEMPOOL_REALBLOCKSIZE(pool);
   irqstate_t flags;
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+  size_t cached = mempool_percpu_count(pool);
+#endif
 
   DEBUGASSERT(pool != NULL && info != NULL);
 
@@ -502,6 +724,12 @@ int mempool_info(FAR struct mempool_s *pool, FAR struct mempoolinfo_s *info)
   info->ordblks = sq_count(&pool->queue);
   info->iordblks = sq_count(&pool->iqueue);
   info->aordblks = pool->nalloc;
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+  /* The blocks held in the per-CPU caches are free */
+
+  info->ordblks += cached;
+  info->aordblks -= cached;
+#endif
   info->arena = sq_count(&pool->equeue) * MEMPOOL_HEADER_SIZE +
     (info->aordblks + info->ordblks + info->iordblks) * blocksize;
   spin_unlock_irqrestore(&pool->lock, flags);
@@ -542,13 +770,21 @@ mempool_info_task(FAR struct mempool_s *pool,
                      sq_count(&pool->iqueue);
 
       spin_unlock_irqrestore(&pool->lock, flags);
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+      count += mempool_percpu_count(pool);
+#endif
       info.aordblks += count;
       info.uordblks += count * blocksize;
     }
   else if (task->pid == PID_MM_ALLOC)
     {
-      info.aordblks += pool->nalloc;
-      info.uordblks += pool->nalloc * blocksize;
+      size_t count = pool->nalloc;
+
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+      count -= mempool_percpu_count(pool);
+#endif
+      info.aordblks += count;
+      info.uordblks += count * blocksize;
     }
 #if CONFIG_MM_BACKTRACE >= 0
   else
@@ -618,6 +854,10 @@ int mempool_deinit(FAR struct mempool_s *pool)
   FAR sq_entry_t *blk;
   size_t count = 0;
 
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+  mempool_percpu_flush(pool);
+#endif
+
   if (pool->nalloc != 0)
     {
       return -EBUSY;
@@ -35,6 +35,16 @@
 #include <nuttx/mm/mempool.h>
 #include <nuttx/mm/kasan.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The maximum number of entries of the size class table, larger pool
+ * layouts fall back to computing the size class on every allocation.
+ */
+
+#define MEMPOOL_MULTIPLE_NCLASS_MAX 512
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -82,6 +92,15 @@ struct mempool_multiple_s
 
   size_t                        delta;
 
+  /* The size class table maps a request size, rounded up to the common
+   * granule of all block sizes, directly to the index of the smallest
+   * pool that fits it.  It is NULL if the table would be too large.
+   */
+
+  FAR uint8_t                  *sizeclass;
+  size_t                        nclass;
+  unsigned int                  classshift;
+
   /* It is used to record the information recorded by the mempool during
    * expansion, and find the mempool by adding an index
    */
@@ -111,6 +130,18 @@ mempool_multiple_find(FAR struct mempool_multiple_s *mpool, size_t size)
       return NULL;
     }
 
+  if (mpool->sizeclass != NULL)
+    {
+      mid = size >> mpool->classshift;
+      if ((size & ((1 << mpool->classshift) - 1)) != 0)
+        {
+          mid++;
+        }
+
+      return mid < mpool->nclass ?
+             &mpool->pools[mpool->sizeclass[mid]] : NULL;
+    }
+
   right = mpool->npools;
   if (mpool->delta != 0)
     {
@@ -405,6 +436,8 @@ mempool_multiple_init(FAR const char *name,
   FAR struct mempool_s *pools;
   size_t maxpoolszie;
   size_t minpoolsize;
+  size_t granule = 0;
+  size_t nclass = 0;
   int ret;
   int i;
 
@@ -426,11 +459,24 @@ mempool_multiple_init(FAR const char *name,
         {
           minpoolsize = poolsize[i];
         }
+
+      granule |= poolsize[i];
+    }
+
+  /* All block sizes are multiples of the lowest set bit of any of them,
+   * so every request size within one granule maps to the same pool.
+   */
+
+  granule &= -granule;
+  if (granule != 0 && npools <= UINT8_MAX &&
+      maxpoolszie / granule < MEMPOOL_MULTIPLE_NCLASS_MAX)
+    {
+      nclass = maxpoolszie / granule + 1;
     }
 
   mpool = alloc(arg, sizeof(uintptr_t),
                 sizeof(struct mempool_multiple_s) +
-                npools * sizeof(struct mempool_s));
+                npools * sizeof(struct mempool_s) + nclass);
 
   if (mpool == NULL)
     {
@@ -452,6 +498,8 @@ mempool_multiple_init(FAR const char *name,
   mpool->npools = npools;
   mpool->minpoolsize = minpoolsize;
   mpool->delta = 0;
+  mpool->sizeclass = NULL;
+  mpool->nclass = 0;
 
   for (i = 0; i < npools; i++)
     {
@@ -485,6 +533,29 @@ mempool_multiple_init(FAR const char *name,
         }
     }
 
+  if (nclass != 0)
+    {
+      FAR uint8_t *sizeclass = (FAR uint8_t *)(pools + npools);
+      size_t index = 0;
+      size_t j;
+
+      /* Entry 'j' holds the smallest pool for sizes up to j * granule */
+
+      for (j = 0; j < nclass; j++)
+        {
+          while (index + 1 < npools && poolsize[index] < j * granule)
+            {
+              index++;
+            }
+
+          sizeclass[j] = index;
+        }
+
+      mpool->classshift = ffs(granule) - 1;
+      mpool->sizeclass = sizeclass;
+      mpool->nclass = nclass;
+    }
+
   mpool->dict_used = 0;
   mpool->dict_col_num_log2 = fls(dict_expendsize /
                                  sizeof(struct mpool_dict_s));
@@ -138,6 +138,9 @@ static ssize_t mempool_read(FAR struct file *filep, FAR char *buffer,
   size_t copysize;
   size_t totalsize;
   off_t offset;
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+  int cpu;
+#endif
 
   offset    = filep->f_pos;
   procfile  = filep->f_priv;
@@ -150,6 +153,21 @@ static ssize_t mempool_read(FAR struct file *filep, FAR char *buffer,
                             &offset);
   totalsize = copysize;
 
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+  if (totalsize < buflen)
+    {
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      linesize   = procfs_snprintf(procfile->line, MEMPOOLINFO_LINELEN,
+                                   "%13s%11s%9s%9s%9s\n", "", "hit",
+                                   "miss", "ncached", "hitrate");
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer,
+                                 buflen, &offset);
+      totalsize += copysize;
+    }
+#endif
+
   for (entry = g_mempool_procfs; entry != NULL; entry = entry->next)
     {
       if (totalsize < buflen)
@@ -171,6 +189,28 @@ static ssize_t mempool_read(FAR struct file *filep, FAR char *buffer,
           copysize   = procfs_memcpy(procfile->line, linesize, buffer,
                                      buflen, &offset);
           totalsize += copysize;
+
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+          for (cpu = 0; cpu < CONFIG_SMP_NCPUS && totalsize < buflen; cpu++)
+            {
+              FAR struct mempool_percpu_s *pcpu = &pool->percpu[cpu];
+              unsigned long total = pcpu->hit + pcpu->miss;
+
+              buffer    += copysize;
+              buflen    -= copysize;
+
+              linesize   = procfs_snprintf(procfile->line,
+                                           MEMPOOLINFO_LINELEN,
+                                           "%9s%3d:%11lu%9lu%9zu%8lu%%\n",
+                                           "cpu", cpu, pcpu->hit,
+                                           pcpu->miss, pcpu->count,
+                                           total ? pcpu->hit * 100 / total
+                                                 : 0);
+              copysize   = procfs_memcpy(procfile->line, linesize, buffer,
+                                         buflen, &offset);
+              totalsize += copysize;
+            }
+#endif
         }
     }
 
@@ -0,0 +1,636 @@
+/****************************************************************************
+ * mm/memprof/memprof.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <inttypes.h>
+#include <sched.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/sched.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/fs/procfs.h>
+#include <nuttx/mm/memprof.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define MEMPROF_NSITES   CONFIG_MM_MEMPROF_NSITES
+#define MEMPROF_NTRACKED CONFIG_MM_MEMPROF_NTRACKED
+#define MEMPROF_DEPTH    CONFIG_MM_MEMPROF_DEPTH
+
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.
+ */
+
+#define MEMPROF_LINELEN  (64 + MEMPROF_DEPTH * 20)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure aggregates the sampled allocations of one call-site */
+
+struct memprof_site_s
+{
+  uint32_t  hash;                      /* Hash of the backtrace, 0 unused */
+  FAR void *backtrace[MEMPROF_DEPTH];  /* The call stack of the site */
+  size_t    inuse_count;               /* Sampled blocks still allocated */
+  size_t    inuse_bytes;               /* Sampled bytes still allocated */
+  size_t    alloc_count;               /* Sampled blocks ever allocated */
+  uint64_t  alloc_bytes;               /* Sampled bytes ever allocated */
+};
+
+/* This structure remembers a sampled block until it is freed */
+
+struct memprof_block_s
+{
+  FAR void *mem;                       /* The block, NULL if unused */
+  size_t    size;                      /* The requested size */
+  uint16_t  site;                      /* Index of the call-site */
+};
+
+struct memprof_s
+{
+  spinlock_t lock;
+  size_t     countdown;                /* Bytes left until the next sample */
+  uint32_t   seed;                     /* State of the interval generator */
+  size_t     ntracked;                 /* Number of tracked blocks */
+  struct memprof_site_s  sites[MEMPROF_NSITES];
+  struct memprof_block_s blocks[MEMPROF_NTRACKED];
+
+  /* Number of tracked blocks per home index of the block table.  A free
+   * whose home index has no tracked block cannot be a sampled block and
+   * returns without taking the lock.
+   */
+
+  uint16_t   tags[MEMPROF_NTRACKED];
+};
+
+/* This structure describes one open "file" */
+
+struct memprof_file_s
+{
+  struct procfs_file_s base;           /* Base open file structure */
+  char line[MEMPROF_LINELEN];          /* Pre-allocated buffer for lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int     memprof_open(FAR struct file *filep, FAR const char *relpath,
+                            int oflags, mode_t mode);
+static int     memprof_close(FAR struct file *filep);
+static ssize_t memprof_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen);
+static int     memprof_dup(FAR const struct file *oldp,
+                           FAR struct file *newp);
+static int     memprof_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct memprof_s g_memprof =
+{
+  SP_UNLOCKED,
+  CONFIG_MM_MEMPROF_SAMPLE_PERIOD,
+  2463534242u
+};
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct procfs_operations g_memprof_operations =
+{
+  memprof_open,   /* open */
+  memprof_close,  /* close */
+  memprof_read,   /* read */
+  NULL,           /* write */
+  NULL,           /* poll */
+  memprof_dup,    /* dup */
+  NULL,           /* opendir */
+  NULL,           /* closedir */
+  NULL,           /* readdir */
+  NULL,           /* rewinddir */
+  memprof_stat    /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: memprof_hash
+ *
+ * Description:
+ *   FNV-1a hash of a backtrace.  Zero is reserved for unused sites.
+ *
+ ****************************************************************************/
+
+static uint32_t memprof_hash(FAR void * const *backtrace, int depth)
+{
+  uint32_t hash = 2166136261u;
+  uintptr_t pc;
+  int i;
+  int j;
+
+  for (i = 0; i < depth; i++)
+    {
+      pc = (uintptr_t)backtrace[i];
+      for (j = 0; j < sizeof(uintptr_t); j++)
+        {
+          hash ^= (uint8_t)(pc >> (j * 8));
+          hash *= 16777619u;
+        }
+    }
+
+  return hash != 0 ? hash : 1;
+}
+
+/****************************************************************************
+ * Name: memprof_interval
+ *
+ * Description:
+ *   Draw the number of bytes until the next sample from an exponential
+ *   distribution with a mean of CONFIG_MM_MEMPROF_SAMPLE_PERIOD, which is
+ *   what the un-sampling of pprof assumes (a Poisson process over the
+ *   allocated bytes).  A fixed period would bias the profile towards
+ *   allocations that happen in step with it.
+ *
+ *   The interval is -ln(u) * period with u uniform in (0, 1].  ln(u) is
+ *   computed as log2(u) * ln(2) in 16.16 fixed point so that no floating
+ *   point is used in the allocation path.
+ *
+ ****************************************************************************/
+
+static size_t memprof_interval(void)
+{
+  uint64_t interval;
+  uint32_t x;
+  uint32_t log2x;
+  uint32_t m;
+  int i;
+
+  if (CONFIG_MM_MEMPROF_SAMPLE_PERIOD <= 1)
+    {
+      return 1;
+    }
+
+  /* xorshift32, the state is updated without the lock like countdown */
+
+  x  = g_memprof.seed;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  g_memprof.seed = x;
+
+  /* log2(x) in 16.16 fixed point.  The integer part is the position of the
+   * most significant bit, the fraction is computed from the normalized
+   * mantissa m (1.31 fixed point) by repeated squaring.
+   */
+
+  log2x = 31 << 16;
+  m = x;
+  while ((m & 0x80000000u) == 0)
+    {
+      m <<= 1;
+      log2x -= 1 << 16;
+    }
+
+  for (i = 15; i >= 0; i--)
+    {
+      uint64_t sq = ((uint64_t)m * m) >> 31;
+
+      if (sq >= ((uint64_t)1 << 32))
+        {
+          sq >>= 1;
+          log2x |= 1 << i;
+        }
+
+      m = (uint32_t)sq;
+    }
+
+  /* -log2(u) = 32 - log2(x) for u = x / 2^32, ln(2) = 45426 / 2^16 */
+
+  interval  = (((uint64_t)32 << 16) - log2x) * 45426;
+  interval  = (interval * CONFIG_MM_MEMPROF_SAMPLE_PERIOD) >> 32;
+  return interval > 0 ? (size_t)interval : 1;
+}
+
+/****************************************************************************
+ * Name: memprof_find_site
+ *
+ * Description:
+ *   Find or create the call-site entry of a backtrace.
+ *
+ * Returned Value:
+ *   The index of the entry or -1 if the table is full.
+ *
+ ****************************************************************************/
+
+static int memprof_find_site(FAR void * const *backtrace, int depth)
+{
+  FAR struct memprof_site_s *site;
+  uint32_t hash = memprof_hash(backtrace, depth);
+  int index = hash % MEMPROF_NSITES;
+  int i;
+
+  for (i = 0; i < MEMPROF_NSITES; i++)
+    {
+      site = &g_memprof.sites[index];
+      if (site->hash == 0)
+        {
+          memset(site, 0, sizeof(*site));
+          memcpy(site->backtrace, backtrace, depth * sizeof(FAR void *));
+          site->hash = hash;
+          return index;
+        }
+      else if (site->hash == hash &&
+               memcmp(site->backtrace, backtrace,
+                      depth * sizeof(FAR void *)) == 0 &&
+               (depth == MEMPROF_DEPTH || site->backtrace[depth] == NULL))
+        {
+          return index;
+        }
+
+      index = (index + 1) % MEMPROF_NSITES;
+    }
+
+  return -1;
+}
+
+/****************************************************************************
+ * Name: memprof_block_index
+ ****************************************************************************/
+
+static inline size_t memprof_block_index(FAR void *mem)
+{
+  return ((uintptr_t)mem >> 4) % MEMPROF_NTRACKED;
+}
+
+/****************************************************************************
+ * Name: memprof_open
+ ****************************************************************************/
+
+static int memprof_open(FAR struct file *filep, FAR const char *relpath,
+                        int oflags, mode_t mode)
+{
+  FAR struct memprof_file_s *procfile;
+
+  procfile = kmm_zalloc(sizeof(struct memprof_file_s));
+  if (procfile == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  filep->f_priv = procfile;
+  return 0;
+}
+
+/****************************************************************************
+ * Name: memprof_close
+ ****************************************************************************/
+
+static int memprof_close(FAR struct file *filep)
+{
+  kmm_free(filep->f_priv);
+  filep->f_priv = NULL;
+  return 0;
+}
+
+/****************************************************************************
+ * Name: memprof_read
+ *
+ * Description:
+ *   Report the aggregated call-sites in the legacy text format of the
+ *   gperftools heap profiler, which pprof understands:
+ *
+ *     heap profile: <inuse>: <bytes> [<allocs>: <bytes>] @ heap_v2/<period>
+ *     <inuse>: <bytes> [<allocs>: <bytes>] @ <pc> <pc> ...
+ *
+ ****************************************************************************/
+
+static ssize_t memprof_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen)
+{
+  FAR struct memprof_file_s *procfile;
+  struct memprof_site_s site;
+  struct memprof_site_s total;
+  irqstate_t flags;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+  int index;
+  int i;
+
+  offset   = filep->f_pos;
+  procfile = filep->f_priv;
+
+  memset(&total, 0, sizeof(total));
+  flags = spin_lock_irqsave(&g_memprof.lock);
+  for (index = 0; index < MEMPROF_NSITES; index++)
+    {
+      total.inuse_count += g_memprof.sites[index].inuse_count;
+      total.inuse_bytes += g_memprof.sites[index].inuse_bytes;
+      total.alloc_count += g_memprof.sites[index].alloc_count;
+      total.alloc_bytes += g_memprof.sites[index].alloc_bytes;
+    }
+
+  spin_unlock_irqrestore(&g_memprof.lock, flags);
+
+  linesize  = procfs_snprintf(procfile->line, MEMPROF_LINELEN,
+                              "heap profile: %zu: %zu [%zu: %" PRIu64 "] "
+                              "@ heap_v2/%d\n",
+                              total.inuse_count, total.inuse_bytes,
+                              total.alloc_count, total.alloc_bytes,
+                              CONFIG_MM_MEMPROF_SAMPLE_PERIOD);
+  copysize  = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                            &offset);
+  totalsize = copysize;
+
+  for (index = 0; index < MEMPROF_NSITES && totalsize < buflen; index++)
+    {
+      /* Take a consistent copy of the site, the lock must not be held
+       * while formatting.
+       */
+
+      flags = spin_lock_irqsave(&g_memprof.lock);
+      site = g_memprof.sites[index];
+      spin_unlock_irqrestore(&g_memprof.lock, flags);
+
+      if (site.hash == 0)
+        {
+          continue;
+        }
+
+      buffer   += copysize;
+      buflen   -= copysize;
+
+      linesize  = procfs_snprintf(procfile->line, MEMPROF_LINELEN,
+                                  "%zu: %zu [%zu: %" PRIu64 "] @",
+                                  site.inuse_count, site.inuse_bytes,
+                                  site.alloc_count, site.alloc_bytes);
+      for (i = 0; i < MEMPROF_DEPTH && site.backtrace[i] != NULL; i++)
+        {
+          linesize += procfs_snprintf(procfile->line + linesize,
+                                      MEMPROF_LINELEN - linesize,
+                                      " %p", site.backtrace[i]);
+        }
+
+      linesize += procfs_snprintf(procfile->line + linesize,
+                                  MEMPROF_LINELEN - linesize, "\n");
+      copysize  = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                &offset);
+      totalsize += copysize;
+    }
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: memprof_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int memprof_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct memprof_file_s *oldattr;
+  FAR struct memprof_file_s *newattr;
+
+  oldattr = oldp->f_priv;
+  newattr = kmm_malloc(sizeof(struct memprof_file_s));
+  if (newattr == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  memcpy(newattr, oldattr, sizeof(struct memprof_file_s));
+  newp->f_priv = newattr;
+  return 0;
+}
+
+/****************************************************************************
+ * Name: memprof_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int memprof_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: memprof_alloc
+ *
+ * Description:
+ *   Account an allocation.  Allocations are sampled at exponentially
+ *   distributed byte intervals with a mean of
+ *   CONFIG_MM_MEMPROF_SAMPLE_PERIOD: the backtrace of a sampled allocation
+ *   is captured, the call-site counters are updated and the block is
+ *   tracked so that its release can be attributed to the same call-site.
+ *
+ *   The sampling countdown is updated without the lock; a race only
+ *   shifts the point at which the next sample is taken.
+ *
+ * Input Parameters:
+ *   mem  - The allocated block.
+ *   size - The requested size.
+ *
+ ****************************************************************************/
+
+void memprof_alloc(FAR void *mem, size_t size)
+{
+  FAR struct memprof_block_s *block;
+  FAR struct memprof_site_s *site;
+  FAR void *backtrace[MEMPROF_DEPTH];
+  irqstate_t flags;
+  size_t index;
+  int depth;
+  int i;
+
+  if (mem == NULL)
+    {
+      return;
+    }
+
+  if (g_memprof.countdown > size)
+    {
+      g_memprof.countdown -= size;
+      return;
+    }
+
+  g_memprof.countdown = memprof_interval();
+
+  /* The backtrace of an interrupt handler is not the one of the thread */
+
+  if (up_interrupt_context())
+    {
+      return;
+    }
+
+  depth = sched_backtrace(_SCHED_GETTID(), backtrace, MEMPROF_DEPTH,
+                          CONFIG_MM_MEMPROF_SKIP);
+  if (depth <= 0)
+    {
+      return;
+    }
+
+  flags = spin_lock_irqsave(&g_memprof.lock);
+
+  i = g_memprof.ntracked < MEMPROF_NTRACKED - 1 ?
+      memprof_find_site(backtrace, depth) : -1;
+  if (i < 0)
+    {
+      spin_unlock_irqrestore(&g_memprof.lock, flags);
+      return;
+    }
+
+  site = &g_memprof.sites[i];
+  site->inuse_count++;
+  site->inuse_bytes += size;
+  site->alloc_count++;
+  site->alloc_bytes += size;
+
+  index = memprof_block_index(mem);
+  g_memprof.tags[index]++;
+  while (g_memprof.blocks[index].mem != NULL)
+    {
+      index = (index + 1) % MEMPROF_NTRACKED;
+    }
+
+  block       = &g_memprof.blocks[index];
+  block->mem  = mem;
+  block->size = size;
+  block->site = i;
+  g_memprof.ntracked++;
+
+  spin_unlock_irqrestore(&g_memprof.lock, flags);
+}
+
+/****************************************************************************
+ * Name: memprof_free
+ *
+ * Description:
+ *   Account the release of a block.  Only sampled blocks are tracked, the
+ *   others are ignored without taking the lock.
+ *
+ * Input Parameters:
+ *   mem - The block being freed.
+ *
+ ****************************************************************************/
+
+void memprof_free(FAR void *mem)
+{
+  FAR struct memprof_block_s *block;
+  FAR struct memprof_site_s *site;
+  irqstate_t flags;
+  size_t index;
+  size_t next;
+  size_t home;
+
+  if (mem == NULL)
+    {
+      return;
+    }
+
+  /* A sampled block was tagged before it was returned to the caller, so
+   * a zero count here means that the block was never sampled.
+   */
+
+  index = memprof_block_index(mem);
+  if (g_memprof.tags[index] == 0)
+    {
+      return;
+    }
+
+  flags = spin_lock_irqsave(&g_memprof.lock);
+
+  while (g_memprof.blocks[index].mem != NULL &&
+         g_memprof.blocks[index].mem != mem)
+    {
+      index = (index + 1) % MEMPROF_NTRACKED;
+    }
+
+  block = &g_memprof.blocks[index];
+  if (block->mem == NULL)
+    {
+      spin_unlock_irqrestore(&g_memprof.lock, flags);
+      return;
+    }
+
+  site = &g_memprof.sites[block->site];
+  site->inuse_count--;
+  site->inuse_bytes -= block->size;
+  g_memprof.tags[memprof_block_index(mem)]--;
+  g_memprof.ntracked--;
+
+  /* Shift the following entries of the probe sequence back so that no
+   * lookup stops early at the hole.
+   */
+
+  next = index;
+  for (; ; )
+    {
+      next = (next + 1) % MEMPROF_NTRACKED;
+      if (g_memprof.blocks[next].mem == NULL)
+        {
+          break;
+        }
+
+      home = memprof_block_index(g_memprof.blocks[next].mem);
+      if ((next > index && (home <= index || home > next)) ||
+          (next < index && (home <= index && home > next)))
+        {
+          g_memprof.blocks[index] = g_memprof.blocks[next];
+          index = next;
+        }
+    }
+
+  g_memprof.blocks[index].mem = NULL;
+  spin_unlock_irqrestore(&g_memprof.lock, flags);
+}
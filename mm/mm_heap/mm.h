@@ -296,6 +296,18 @@ void mm_shrinkchunk(FAR struct mm_heap_s *heap,
 void mm_foreach(FAR struct mm_heap_s *heap, mm_node_handler_t handler,
                 FAR void *arg);
 
+/* Functions contained in mm_huge.c *****************************************/
+
+#if defined(CONFIG_MM_HEAP_HUGE) && defined(__KERNEL__)
+FAR void *mm_huge_malloc(FAR struct mm_heap_s *heap, size_t size);
+bool mm_huge_free(FAR struct mm_heap_s *heap, FAR void *mem);
+size_t mm_huge_size(FAR struct mm_heap_s *heap, FAR void *mem);
+#else
+#  define mm_huge_malloc(heap, size) NULL
+#  define mm_huge_free(heap, mem)    false
+#  define mm_huge_size(heap, mem)    0
+#endif
+
 /* Functions contained in mm_free.c *****************************************/
 
 void mm_delayfree(FAR struct mm_heap_s *heap, FAR void *mem, bool delay);
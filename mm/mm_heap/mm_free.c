@@ -33,6 +33,7 @@
 #include <nuttx/sched.h>
 #include <nuttx/mm/mm.h>
 #include <nuttx/mm/kasan.h>
+#include <nuttx/mm/memprof.h>
 #include <nuttx/sched_note.h>
 
 #include "mm_heap/mm.h"
@@ -55,7 +56,7 @@ static void add_delaylist(FAR struct mm_heap_s *heap, FAR void *mem)
   FAR struct mm_freenode_s *node;
 
   node = (FAR struct mm_freenode_s *)((FAR char *)mem - MM_SIZEOF_ALLOCNODE);
-  DEBUGASSERT(MM_NODE_IS_ALLOC(node));
+  DEBUGASSERT(mm_huge_size(heap, mem) != 0 || MM_NODE_IS_ALLOC(node));
 #  endif
 
   tmp->flink = heap->mm_delaylist[this_cpu()];
@@ -69,6 +70,39 @@ static void add_delaylist(FAR struct mm_heap_s *heap, FAR void *mem)
 #endif
 }
 
+/****************************************************************************
+ * Name: free_huge
+ *
+ * Description:
+ *   Free 'mem' if it is a huge block.  The page allocator may sleep, so
+ *   the pages are only returned when the caller can wait.  Otherwise the
+ *   block goes to the delay list like heap blocks that cannot be freed
+ *   immediately.
+ *
+ * Returned Value:
+ *   True if 'mem' was a huge block.
+ *
+ ****************************************************************************/
+
+static bool free_huge(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  if (mm_huge_size(heap, mem) == 0)
+    {
+      return false;
+    }
+
+  if (up_interrupt_context() || _SCHED_GETTID() < 0)
+    {
+      add_delaylist(heap, mem);
+    }
+  else
+    {
+      mm_huge_free(heap, mem);
+    }
+
+  return true;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -89,6 +123,13 @@ void mm_delayfree(FAR struct mm_heap_s *heap, FAR void *mem, bool delay)
   size_t nodesize;
   size_t prevsize;
 
+  /* Huge blocks come back here when the delay list is drained */
+
+  if (free_huge(heap, mem))
+    {
+      return;
+    }
+
   if (mm_lock(heap) < 0)
     {
       /* Meet -ESRCH return, which means we are in situations
@@ -241,6 +282,12 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
     }
 
   DEBUGASSERT(mm_heapmember(heap, mem));
+  memprof_free(mem);
+
+  if (free_huge(heap, mem))
+    {
+      return;
+    }
 
 #ifdef CONFIG_MM_HEAP_MEMPOOL
   if (heap->mm_mpool)
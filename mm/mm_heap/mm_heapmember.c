@@ -58,6 +58,11 @@
 bool mm_heapmember(FAR struct mm_heap_s *heap, FAR void *mem)
 {
   mem = kasan_reset_tag(mem);
+  if (mm_huge_size(heap, mem) != 0)
+    {
+      return true;
+    }
+
 #if CONFIG_MM_REGIONS > 1
   int i;
 
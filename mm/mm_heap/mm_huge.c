@@ -0,0 +1,251 @@
+/****************************************************************************
+ * mm/mm_heap/mm_huge.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <debug.h>
+#include <stdbool.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/nuttx.h>
+#include <nuttx/pgalloc.h>
+#include <nuttx/queue.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/mm/mm.h>
+
+#include "mm_heap/mm.h"
+
+#if defined(CONFIG_MM_HEAP_HUGE) && defined(__KERNEL__)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define MM_HUGE_HEADERSIZE ALIGN_UP(sizeof(struct mm_huge_s), MM_ALIGN)
+
+/* Only pointers that pass this test need to be looked up in the list of
+ * huge blocks.  The page offset filters out nearly all heap blocks.
+ */
+
+#define MM_HUGE_CANDIDATE(heap, mem) \
+  ((heap) == g_kmmheap && (mem) != NULL && \
+   ((uintptr_t)(mem) & (MM_PGSIZE - 1)) == MM_HUGE_HEADERSIZE)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This header is kept at the start of the first page of a huge block */
+
+struct mm_huge_s
+{
+  dq_entry_t node;   /* Link in g_mm_huge */
+  uintptr_t  paddr;  /* Physical address of the first page */
+  size_t     npages; /* Number of pages of the block */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* All live huge blocks.  A pointer is only recognized as a huge block if
+ * its header is in this list, so no memory outside of the heap is ever
+ * read to find out.
+ */
+
+static dq_queue_t g_mm_huge;
+static spinlock_t g_mm_huge_lock;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_huge_header
+ *
+ * Description:
+ *   Return the header of a huge block or NULL if 'mem' is not one.
+ *
+ * Assumptions:
+ *   The caller holds g_mm_huge_lock.
+ *
+ ****************************************************************************/
+
+static FAR struct mm_huge_s *mm_huge_header(FAR void *mem)
+{
+  FAR dq_entry_t *entry;
+
+  for (entry = dq_peek(&g_mm_huge); entry != NULL; entry = dq_next(entry))
+    {
+      if ((FAR char *)entry + MM_HUGE_HEADERSIZE == mem)
+        {
+          return (FAR struct mm_huge_s *)entry;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_huge_malloc
+ *
+ * Description:
+ *   Allocate a huge block of the kernel heap directly from the page
+ *   allocator, so that it does not fragment the heap and its pages are
+ *   given back as soon as it is freed.
+ *
+ * Input Parameters:
+ *   heap - The heap the request was made on.
+ *   size - Size (in bytes) of the memory region to be allocated.
+ *
+ * Returned Value:
+ *   The address of the block or NULL if the request must be served by the
+ *   heap itself.  The page allocator may sleep, so interrupt handlers are
+ *   always served by the heap.
+ *
+ ****************************************************************************/
+
+FAR void *mm_huge_malloc(FAR struct mm_heap_s *heap, size_t size)
+{
+  FAR struct mm_huge_s *huge;
+  irqstate_t flags;
+  uintptr_t paddr;
+  size_t npages;
+
+  if (heap != g_kmmheap || size < CONFIG_MM_HEAP_HUGE_THRESHOLD ||
+      size > SIZE_MAX - MM_HUGE_HEADERSIZE - MM_PGSIZE ||
+      up_interrupt_context())
+    {
+      return NULL;
+    }
+
+  npages = (size + MM_HUGE_HEADERSIZE + MM_PGSIZE - 1) >> MM_PGSHIFT;
+  paddr  = mm_pgalloc(npages);
+  if (paddr == 0)
+    {
+      return NULL;
+    }
+
+  /* The page pool is mapped linearly into the kernel address space */
+
+  huge = (FAR struct mm_huge_s *)up_addrenv_page_vaddr(paddr);
+  if (huge == NULL)
+    {
+      mm_pgfree(paddr, npages);
+      return NULL;
+    }
+
+  huge->paddr  = paddr;
+  huge->npages = npages;
+
+  flags = spin_lock_irqsave(&g_mm_huge_lock);
+  dq_addlast(&huge->node, &g_mm_huge);
+  spin_unlock_irqrestore(&g_mm_huge_lock, flags);
+
+  minfo("Huge %p, size %zu, %zu pages\n", huge, size, npages);
+  return (FAR char *)huge + MM_HUGE_HEADERSIZE;
+}
+
+/****************************************************************************
+ * Name: mm_huge_free
+ *
+ * Description:
+ *   Give the pages of a huge block back to the page allocator.
+ *
+ * Returned Value:
+ *   True if 'mem' was a huge block; false if it belongs to the heap.
+ *
+ * Assumptions:
+ *   Not called from an interrupt handler, the page allocator may sleep.
+ *
+ ****************************************************************************/
+
+bool mm_huge_free(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  FAR struct mm_huge_s *huge;
+  irqstate_t flags;
+
+  if (!MM_HUGE_CANDIDATE(heap, mem))
+    {
+      return false;
+    }
+
+  DEBUGASSERT(!up_interrupt_context());
+
+  flags = spin_lock_irqsave(&g_mm_huge_lock);
+  huge = mm_huge_header(mem);
+  if (huge != NULL)
+    {
+      dq_rem(&huge->node, &g_mm_huge);
+    }
+
+  spin_unlock_irqrestore(&g_mm_huge_lock, flags);
+
+  if (huge == NULL)
+    {
+      return false;
+    }
+
+  mm_pgfree(huge->paddr, huge->npages);
+  return true;
+}
+
+/****************************************************************************
+ * Name: mm_huge_size
+ *
+ * Description:
+ *   Return the usable size of a huge block or zero if 'mem' is not one.
+ *
+ ****************************************************************************/
+
+size_t mm_huge_size(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  FAR struct mm_huge_s *huge;
+  irqstate_t flags;
+  size_t size = 0;
+
+  if (!MM_HUGE_CANDIDATE(heap, mem))
+    {
+      return 0;
+    }
+
+  flags = spin_lock_irqsave(&g_mm_huge_lock);
+  huge = mm_huge_header(mem);
+  if (huge != NULL)
+    {
+      size = (huge->npages << MM_PGSHIFT) - MM_HUGE_HEADERSIZE;
+    }
+
+  spin_unlock_irqrestore(&g_mm_huge_lock, flags);
+  return size;
+}
+
+#endif /* CONFIG_MM_HEAP_HUGE && __KERNEL__ */
@@ -33,6 +33,7 @@
 #include <nuttx/arch.h>
 #include <nuttx/mm/mm.h>
 #include <nuttx/mm/kasan.h>
+#include <nuttx/mm/memprof.h>
 #include <nuttx/sched.h>
 #include <nuttx/sched_note.h>
 
@@ -179,12 +180,22 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 
   free_delaylist(heap, false);
 
+  /* Serve huge requests from the page allocator */
+
+  ret = mm_huge_malloc(heap, size);
+  if (ret != NULL)
+    {
+      memprof_alloc(ret, size);
+      return ret;
+    }
+
 #ifdef CONFIG_MM_HEAP_MEMPOOL
   if (heap->mm_mpool)
     {
       ret = mempool_multiple_alloc(heap->mm_mpool, size);
       if (ret != NULL)
         {
+          memprof_alloc(ret, size);
           return ret;
         }
     }
@@ -334,6 +345,7 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
     {
       MM_ADD_BACKTRACE(heap, node);
       ret = kasan_unpoison(ret, nodesize - MM_ALLOCNODE_OVERHEAD);
+      memprof_alloc(ret, size);
 #ifdef CONFIG_MM_FILL_ALLOCATIONS
       memset(ret, MM_ALLOC_MAGIC, alignsize - MM_ALLOCNODE_OVERHEAD);
 #endif
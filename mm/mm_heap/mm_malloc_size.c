@@ -40,6 +40,13 @@
 size_t mm_malloc_size(FAR struct mm_heap_s *heap, FAR void *mem)
 {
   FAR struct mm_freenode_s *node;
+  size_t hugesize = mm_huge_size(heap, mem);
+
+  if (hugesize != 0)
+    {
+      return hugesize;
+    }
+
 #ifdef CONFIG_MM_HEAP_MEMPOOL
   if (heap->mm_mpool)
     {
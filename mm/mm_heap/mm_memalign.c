@@ -31,6 +31,7 @@
 
 #include <nuttx/mm/mm.h>
 #include <nuttx/mm/kasan.h>
+#include <nuttx/mm/memprof.h>
 #include <nuttx/sched_note.h>
 
 #include "mm_heap/mm.h"
@@ -82,6 +83,7 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
       node = mempool_multiple_memalign(heap->mm_mpool, alignment, size);
       if (node != NULL)
         {
+          memprof_alloc(node, size);
           return node;
         }
     }
@@ -288,6 +290,7 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
   alignedchunk = (uintptr_t)kasan_unpoison((FAR const void *)alignedchunk,
                                            size - MM_ALLOCNODE_OVERHEAD);
   DEBUGASSERT(alignedchunk % alignment == 0);
+  memprof_alloc((FAR void *)alignedchunk, size - MM_ALLOCNODE_OVERHEAD);
   minfo("Aligned %"PRIxPTR" to %"PRIxPTR", size %zu\n",
         rawchunk, alignedchunk, size);
   return (FAR void *)alignedchunk;
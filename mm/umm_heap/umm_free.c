@@ -48,5 +48,12 @@
 #undef free /* See mm/README.txt */
 void free(FAR void *mem)
 {
+#ifdef CONFIG_MM_TCACHE
+  if (umm_tcache_free(mem))
+    {
+      return;
+    }
+#endif
+
   mm_free(USR_HEAP, mem);
 }
@@ -44,4 +44,9 @@
 void umm_try_initialize(void);
 #endif
 
+#ifdef CONFIG_MM_TCACHE
+FAR void *umm_tcache_alloc(size_t size);
+bool umm_tcache_free(FAR void *mem);
+#endif
+
 #endif /* __MM_UMM_HEAP_UMM_HEAP_H */
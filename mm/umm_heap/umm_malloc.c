@@ -63,7 +63,11 @@ FAR void *malloc(size_t size)
 
   /* Use mm_malloc() because it implements the clear */
 
+#ifdef CONFIG_MM_TCACHE
+  ret = umm_tcache_alloc(size);
+#else
   ret = mm_malloc(USR_HEAP, size);
+#endif
   if (ret == NULL)
     {
       set_errno(ENOMEM);
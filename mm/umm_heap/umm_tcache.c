@@ -0,0 +1,259 @@
+/****************************************************************************
+ * mm/umm_heap/umm_tcache.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/sched.h>
+#include <nuttx/tls.h>
+#include <nuttx/mm/mm.h>
+
+#include "umm_heap/umm_heap.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Cached blocks are sorted into classes of UMM_TCACHE_GRANULE bytes.  A
+ * block in class 'n' is able to hold at least (n + 1) granules.
+ */
+
+#define UMM_TCACHE_GRANULE  (4 * sizeof(uintptr_t))
+#define UMM_TCACHE_NCLASS   ((CONFIG_MM_TCACHE_MAXSIZE + \
+                              UMM_TCACHE_GRANULE - 1) / UMM_TCACHE_GRANULE)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The free blocks of one class are linked through their first word.  The
+ * blocks are still allocated from the point of view of the heap.
+ */
+
+struct umm_tcache_s
+{
+  FAR void *head[UMM_TCACHE_NCLASS];
+  uint8_t   count[UMM_TCACHE_NCLASS];
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: umm_tcache_get
+ *
+ * Description:
+ *   Return the TLS of the calling thread if its cache may be used.  The
+ *   cache must not be touched from interrupt handlers, which run on the
+ *   stack of whatever thread they interrupted.
+ *
+ ****************************************************************************/
+
+static FAR struct tls_info_s *umm_tcache_get(void)
+{
+#if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+  if (up_interrupt_context())
+    {
+      return NULL;
+    }
+#endif
+
+  return tls_get_info();
+}
+
+/****************************************************************************
+ * Name: umm_tcache_trim
+ *
+ * Description:
+ *   Return the 'nfree' first blocks of one class to the user heap.
+ *
+ ****************************************************************************/
+
+static void umm_tcache_trim(FAR struct umm_tcache_s *tcache, int index,
+                            int nfree)
+{
+  FAR void *mem;
+
+  while (nfree-- > 0 && tcache->head[index] != NULL)
+    {
+      mem = tcache->head[index];
+      tcache->head[index] = *(FAR void **)mem;
+      tcache->count[index]--;
+      mm_free(USR_HEAP, mem);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: umm_tcache_alloc
+ *
+ * Description:
+ *   Allocate a block from the cache of the calling thread.  On a miss the
+ *   block is taken from the user heap with its size rounded up to the
+ *   class, so that it returns to the same class when it is freed.
+ *
+ * Input Parameters:
+ *   size - Size (in bytes) of the memory region to be allocated.
+ *
+ * Returned Value:
+ *   The address of the allocated memory (NULL on failure to allocate)
+ *
+ ****************************************************************************/
+
+FAR void *umm_tcache_alloc(size_t size)
+{
+  FAR struct umm_tcache_s *tcache;
+  FAR struct tls_info_s *info;
+  FAR void *mem;
+  int index;
+
+  if (size > CONFIG_MM_TCACHE_MAXSIZE)
+    {
+      return mm_malloc(USR_HEAP, size);
+    }
+
+  index = size > 0 ? (size - 1) / UMM_TCACHE_GRANULE : 0;
+  info  = umm_tcache_get();
+  if (info != NULL && (tcache = info->tl_tcache) != NULL &&
+      tcache->head[index] != NULL)
+    {
+      mem = tcache->head[index];
+      tcache->head[index] = *(FAR void **)mem;
+      tcache->count[index]--;
+      return mem;
+    }
+
+  return mm_malloc(USR_HEAP, (index + 1) * UMM_TCACHE_GRANULE);
+}
+
+/****************************************************************************
+ * Name: umm_tcache_free
+ *
+ * Description:
+ *   Keep a small block in the cache of the calling thread.  The cache of
+ *   the thread is created on the first free.  When a class overflows,
+ *   half of it is given back to the user heap in one go.
+ *
+ * Input Parameters:
+ *   mem - The memory to be freed.
+ *
+ * Returned Value:
+ *   True if the block was cached; false if it must be freed to the heap.
+ *
+ ****************************************************************************/
+
+bool umm_tcache_free(FAR void *mem)
+{
+  FAR struct umm_tcache_s *tcache;
+  FAR struct tls_info_s *info;
+  size_t size;
+  int index;
+
+  if (mem == NULL)
+    {
+      return false;
+    }
+
+  size = mm_malloc_size(USR_HEAP, mem);
+  if (size < UMM_TCACHE_GRANULE)
+    {
+      return false;
+    }
+
+  index = size / UMM_TCACHE_GRANULE - 1;
+  if (index >= UMM_TCACHE_NCLASS)
+    {
+      return false;
+    }
+
+  info = umm_tcache_get();
+  if (info == NULL)
+    {
+      return false;
+    }
+
+  tcache = info->tl_tcache;
+  if (tcache == NULL)
+    {
+      tcache = mm_zalloc(USR_HEAP, sizeof(struct umm_tcache_s));
+      if (tcache == NULL)
+        {
+          return false;
+        }
+
+      info->tl_tcache = tcache;
+    }
+
+  if (tcache->count[index] >= CONFIG_MM_TCACHE_COUNT)
+    {
+      umm_tcache_trim(tcache, index, (CONFIG_MM_TCACHE_COUNT + 1) / 2);
+    }
+
+  *(FAR void **)mem = tcache->head[index];
+  tcache->head[index] = mem;
+  tcache->count[index]++;
+  return true;
+}
+
+/****************************************************************************
+ * Name: umm_tcache_destroy
+ *
+ * Description:
+ *   Return all blocks cached by a thread to the user heap and release the
+ *   cache itself.  This is called when the thread exits.
+ *
+ * Input Parameters:
+ *   info - The TLS of the exiting thread.
+ *
+ ****************************************************************************/
+
+void umm_tcache_destroy(FAR struct tls_info_s *info)
+{
+  FAR struct umm_tcache_s *tcache;
+  int index;
+
+  if (info == NULL || info->tl_tcache == NULL)
+    {
+      return;
+    }
+
+  tcache = info->tl_tcache;
+  info->tl_tcache = NULL;
+
+  for (index = 0; index < UMM_TCACHE_NCLASS; index++)
+    {
+      umm_tcache_trim(tcache, index, tcache->count[index]);
+    }
+
+  mm_free(USR_HEAP, tcache);
+}
@@ -500,6 +500,27 @@ int devif_file_send(FAR struct net_driver_s *dev, FAR struct file *file,
                     unsigned int target_offset);
 #endif
 
+/****************************************************************************
+ * Name: devif_xip_send
+ *
+ * Description:
+ *   Called from socket logic in response to a xmit or poll request from the
+ *   the network interface driver.
+ *
+ *   This is identical to calling devif_file_send() except that the file
+ *   data is directly addressable in memory.  It is referenced from the
+ *   packet instead of being read into I/O buffers.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_MM_IOB) && defined(CONFIG_IOB_ALLOC)
+int devif_xip_send(FAR struct net_driver_s *dev, FAR const void *buf,
+                   unsigned int len, unsigned int target_offset);
+#endif
+
 /****************************************************************************
  * Name: devif_out
  *
@@ -26,6 +26,7 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
 #include <string.h>
 #include <assert.h>
 #include <debug.h>
@@ -37,6 +38,26 @@
 
 #ifdef CONFIG_MM_IOB
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: devif_xip_free
+ *
+ * Description:
+ *   Free callback of the I/O buffers referencing file data.  The memory
+ *   is the immutable image of an XIP file system, there is nothing to
+ *   release.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_ALLOC
+static void devif_xip_free(FAR void *data)
+{
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -163,4 +184,117 @@ errout:
   return ret;
 }
 
+/****************************************************************************
+ * Name: devif_xip_send
+ *
+ * Description:
+ *   Called from socket logic in response to a xmit or poll request from the
+ *   the network interface driver.
+ *
+ *   This is identical to calling devif_file_send() except that the file
+ *   data is immutable and directly addressable in memory (XIP ROMFS, see
+ *   file_xipdata()).  The I/O buffer holding the protocol headers is
+ *   filled by copy, as every I/O buffer but the last one of a packet must
+ *   be full.  The rest of the data is referenced from the packet instead
+ *   of being read into I/O buffers.
+ *
+ * Input Parameters:
+ *   dev           - The network device
+ *   buf           - The file data to send, valid until the packet is freed
+ *   len           - The number of bytes to send
+ *   target_offset - Offset of the payload in the packet
+ *
+ * Returned Value:
+ *   The amount of data sent, or negated ERRNO in case of failure.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_ALLOC
+int devif_xip_send(FAR struct net_driver_s *dev, FAR const void *buf,
+                   unsigned int len, unsigned int target_offset)
+{
+  FAR const uint8_t *src = buf;
+  FAR struct iob_s *iob;
+  unsigned int copying;
+  int ret;
+
+  if (dev == NULL)
+    {
+      ret = -ENODEV;
+      goto errout;
+    }
+
+  if (len == 0 || len > UINT16_MAX)
+    {
+      ret = -EINVAL;
+      goto errout;
+    }
+
+#ifndef CONFIG_NET_IPFRAG
+  if (len > NETDEV_PKTSIZE(dev) - NET_LL_HDRLEN(dev) - target_offset)
+    {
+      ret = -EMSGSIZE;
+      goto errout;
+    }
+#endif
+
+  if (netdev_iob_prepare(dev, false, 0) != OK)
+    {
+      ret = -ENOMEM;
+      goto errout;
+    }
+
+  iob_update_pktlen(dev->d_iob, target_offset, false);
+
+  /* Copy the head of the data behind the protocol headers */
+
+  iob = dev->d_iob;
+  while (iob->io_flink != NULL)
+    {
+      iob = iob->io_flink;
+    }
+
+  copying = IOB_BUFSIZE(iob) - iob->io_offset - iob->io_len;
+  if (copying > len)
+    {
+      copying = len;
+    }
+
+  memcpy(iob->io_data + iob->io_offset + iob->io_len, src, copying);
+  iob->io_len += copying;
+
+  /* And reference the rest */
+
+  if (len > copying)
+    {
+      iob->io_flink = iob_alloc_with_data((FAR void *)(src + copying),
+                                          len - copying, devif_xip_free);
+      if (iob->io_flink == NULL)
+        {
+          ret = -ENOMEM;
+          goto errout;
+        }
+
+      iob->io_flink->io_len = len - copying;
+    }
+
+  dev->d_iob->io_pktlen = target_offset + len;
+
+  dev->d_sndlen = len;
+  return len;
+
+errout:
+  if (dev != NULL)
+    {
+      netdev_iob_release(dev);
+    }
+
+  nerr("ERROR: devif_xip_send error: %d\n", ret);
+  return ret;
+}
+#endif
+
 #endif /* CONFIG_MM_IOB */
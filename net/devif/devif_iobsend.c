@@ -73,13 +73,30 @@ int devif_iob_send(FAR struct net_driver_s *dev, FAR struct iob_s *iob,
       goto errout;
     }
 
-#ifndef CONFIG_NET_IPFRAG
-  if (len > NETDEV_PKTSIZE(dev) - NET_LL_HDRLEN(dev) - target_offset)
+#ifdef CONFIG_NETDEV_OFFLOAD
+  /* A device with segmentation offload takes packets of up to
+   * CONFIG_NETDEV_GSO_MAXSIZE bytes.
+   */
+
+  if (NETDEV_HAS_FEATURE(dev, NETDEV_F_GSO))
     {
-      ret = -EMSGSIZE;
-      goto errout;
+      if (len > CONFIG_NETDEV_GSO_MAXSIZE - target_offset)
+        {
+          ret = -EMSGSIZE;
+          goto errout;
+        }
     }
+  else
 #endif
+    {
+#ifndef CONFIG_NET_IPFRAG
+      if (len > NETDEV_PKTSIZE(dev) - NET_LL_HDRLEN(dev) - target_offset)
+        {
+          ret = -EMSGSIZE;
+          goto errout;
+        }
+#endif
+    }
 
   /* Append the send buffer after device buffer */
 
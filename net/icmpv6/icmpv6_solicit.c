@@ -126,6 +126,12 @@ void icmpv6_solicit(FAR struct net_driver_s *dev,
 
   iob_update_pktlen(dev->d_iob, IPv6_HDRLEN + l3size, false);
 
+#ifdef CONFIG_NETDEV_OFFLOAD
+  /* The message may replace an outgoing TCP packet with offload flags */
+
+  dev->d_iob->io_offload = 0;
+#endif
+
   /* Calculate the checksum over both the ICMP header and payload */
 
   sol->chksum   = 0;
@@ -171,6 +171,12 @@ static uint32_t ipv4_fragin_reassemble(FAR struct ip_fragsnode_s *node)
       fraglink = linknext;
     }
 
+#ifdef CONFIG_NETDEV_OFFLOAD
+  /* The device can not have verified the checksum of the whole datagram */
+
+  head->io_offload = 0;
+#endif
+
   /* Remember the reassembled outgoing IP frame */
 
   node->outgoframe = head;
@@ -79,6 +79,12 @@ int netdev_iob_prepare(FAR struct net_driver_s *dev, bool throttled,
 
   iob_reserve(dev->d_iob, CONFIG_NET_LL_GUARDSIZE);
 
+#ifdef CONFIG_NETDEV_OFFLOAD
+  /* A reused buffer must not carry the offload flags of its last packet */
+
+  dev->d_iob->io_offload = 0;
+#endif
+
   /* Set the device buffer to l2 */
 
   dev->d_buf = NETLLBUF;
@@ -233,6 +233,28 @@ uint16_t pkt_callback(FAR struct net_driver_s *dev,
 ssize_t pkt_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
                     int flags);
 
+/****************************************************************************
+ * Name: pkt_recvmmsg
+ *
+ * Description:
+ *   Implements the batch receive of recvmmsg() for packet sockets: the
+ *   packets already buffered are received into several messages under a
+ *   single network lock, without waiting.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   msgvec   Buffers to receive the packets
+ *   vlen     The number of messages in msgvec
+ *   flags    Receive flags
+ *
+ * Returned Value:
+ *   The number of packets received, possibly zero.
+ *
+ ****************************************************************************/
+
+int pkt_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                 unsigned int vlen, int flags);
+
 /****************************************************************************
  * Name: pkt_find_device
  *
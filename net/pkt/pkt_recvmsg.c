@@ -505,4 +505,61 @@ errout_with_state:
   return ret;
 }
 
+/****************************************************************************
+ * Name: pkt_recvmmsg
+ *
+ * Description:
+ *   Implements the batch receive of recvmmsg() for packet sockets: the
+ *   packets already buffered are received into several messages under a
+ *   single network lock, without waiting.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   msgvec   Buffers to receive the packets
+ *   vlen     The number of messages in msgvec
+ *   flags    Receive flags
+ *
+ * Returned Value:
+ *   The number of packets received, possibly zero.
+ *
+ ****************************************************************************/
+
+int pkt_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                 unsigned int vlen, int flags)
+{
+  FAR struct pkt_conn_s *conn = psock->s_conn;
+  unsigned int nrecv;
+
+  if (psock->s_type != SOCK_RAW)
+    {
+      return 0;
+    }
+
+  net_lock();
+
+  for (nrecv = 0; nrecv < vlen && !IOB_QEMPTY(&conn->readahead); nrecv++)
+    {
+      FAR struct msghdr *msg = &msgvec[nrecv].msg_hdr;
+
+      /* Invalid messages are left to recvmsg() to report */
+
+      if (msg->msg_iovlen != 1 || msg->msg_iov == NULL ||
+          msg->msg_iov->iov_base == NULL ||
+          (msg->msg_name != NULL && msg->msg_namelen < sizeof(sa_family_t)))
+        {
+          break;
+        }
+
+      msgvec[nrecv].msg_len = pkt_readahead(conn, msg->msg_iov->iov_base,
+                                            msg->msg_iov->iov_len);
+
+      /* No control message is returned */
+
+      msg->msg_controllen = 0;
+    }
+
+  net_unlock();
+  return nrecv;
+}
+
 #endif /* CONFIG_NET */
@@ -0,0 +1,235 @@
+/****************************************************************************
+ * net/socket/recvmmsg.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/uio.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/clock.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+
+#ifdef CONFIG_NET
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_recvmmsg
+ *
+ * Description:
+ *   psock_recvmmsg() receives several messages from a socket.  This is an
+ *   internal OS interface.  It is functionally equivalent to recvmmsg()
+ *   except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - It accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ * Input Parameters:
+ *   psock     A pointer to a NuttX-specific, internal socket structure
+ *   msgvec    Buffers to receive the messages
+ *   vlen      The number of messages in msgvec
+ *   flags     Receive flags
+ *   timeout   Time after which no further message is waited for, or NULL
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received, msg_len of each
+ *   of them holds the number of bytes received.  If no message could be
+ *   received, a negated errno value is returned (see comments with
+ *   recvmsg() for a list of appropriate errno values).  An error after the
+ *   first message is only recorded as the socket error.
+ *
+ ****************************************************************************/
+
+int psock_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags,
+                   FAR struct timespec *timeout)
+{
+  unsigned int nrecv = 0;
+  clock_t start = 0;
+  clock_t ticks = 0;
+  ssize_t ret = OK;
+
+  /* Verify that the sockfd corresponds to valid, allocated socket */
+
+  if (psock == NULL || psock->s_conn == NULL)
+    {
+      return -EBADF;
+    }
+
+  if (msgvec == NULL && vlen > 0)
+    {
+      return -EINVAL;
+    }
+
+  /* As on Linux, at most UIO_MAXIOV messages are handled per call */
+
+  if (vlen > UIO_MAXIOV)
+    {
+      vlen = UIO_MAXIOV;
+    }
+
+  if (timeout != NULL)
+    {
+      start = clock_systime_ticks();
+      ticks = clock_time2ticks(timeout);
+    }
+
+  DEBUGASSERT(psock->s_sockif != NULL);
+
+  while (nrecv < vlen)
+    {
+      /* Receive the next message as recvmsg() would, waiting for it if
+       * needed.
+       */
+
+      ret = psock_recvmsg(psock, &msgvec[nrecv].msg_hdr,
+                          flags & ~MSG_WAITFORONE);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      msgvec[nrecv++].msg_len = ret;
+
+      /* Then take all the messages already queued at once, if the socket
+       * supports it.
+       */
+
+      if (nrecv < vlen && psock->s_sockif->si_recvmmsg != NULL)
+        {
+          ret = psock->s_sockif->si_recvmmsg(psock, &msgvec[nrecv],
+                                             vlen - nrecv,
+                                             (flags & ~MSG_WAITFORONE) |
+                                             MSG_DONTWAIT);
+          if (ret < 0)
+            {
+              break;
+            }
+
+          nrecv += ret;
+        }
+
+      /* MSG_WAITFORONE: Only wait for the first message */
+
+      if ((flags & MSG_WAITFORONE) != 0)
+        {
+          flags |= MSG_DONTWAIT;
+        }
+
+      /* The timeout is checked after each message, as on Linux */
+
+      if (timeout != NULL && clock_systime_ticks() - start >= ticks)
+        {
+          break;
+        }
+    }
+
+  /* An error is only returned if nothing was received.  Otherwise, as on
+   * Linux, the call succeeds with the number of messages received and the
+   * error, unless it only means that no more messages are queued, is kept
+   * as the socket error (SO_ERROR).
+   */
+
+  if (nrecv > 0)
+    {
+      if (ret < 0 && ret != -EAGAIN)
+        {
+          _SO_SETERRNO(psock, -ret);
+        }
+
+      return nrecv;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Function: recvmmsg
+ *
+ * Description:
+ *   recvmmsg() receives up to vlen messages from a socket with a single
+ *   call.  On a blocking socket, it waits until vlen messages have been
+ *   received, unless MSG_WAITFORONE is set, in which case it only waits for
+ *   the first one.  The messages that are already queued are received in
+ *   one go when the socket supports it.
+ *
+ * Parameters:
+ *   sockfd   Socket descriptor of socket
+ *   msgvec   Buffers to receive the messages
+ *   vlen     The number of messages in msgvec
+ *   flags    Receive flags
+ *   timeout  Time after which no further message is waited for, or NULL
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received, msg_len of each
+ *   of them holds the number of bytes received.  On error, -1 is returned,
+ *   and errno is set appropriately (see recvmsg()).
+ *
+ ****************************************************************************/
+
+int recvmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags, FAR struct timespec *timeout)
+{
+  FAR struct socket *psock;
+  FAR struct file *filep;
+  int ret;
+
+  /* recvmmsg() is a cancellation point */
+
+  enter_cancellation_point();
+
+  /* Get the underlying socket structure */
+
+  ret = sockfd_socket(sockfd, &filep, &psock);
+
+  /* Let psock_recvmmsg() do all of the work */
+
+  if (ret == OK)
+    {
+      ret = psock_recvmmsg(psock, msgvec, vlen, flags, timeout);
+      file_put(filep);
+    }
+
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+#endif /* CONFIG_NET */
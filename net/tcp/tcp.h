@@ -32,6 +32,7 @@
 #include <sys/types.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/hashtable.h>
 #include <nuttx/queue.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/mm/iob.h>
@@ -82,6 +83,12 @@
 #  define TCP_WBTRIM(wrb,n) \
      do { (wrb)->wb_iob = iob_trimhead((wrb)->wb_iob,(n)); } while (0)
 
+#ifdef CONFIG_NET_TCP_ZEROCOPY
+#  define TCP_WBZCOPY(wrb)           ((wrb)->wb_zcopy)
+#else
+#  define TCP_WBZCOPY(wrb)           NULL
+#endif
+
 #ifdef CONFIG_DEBUG_FEATURES
 #  define TCP_WBDUMP(msg,wrb,len,offset) \
      tcp_wrbuffer_dump(msg,wrb,len,offset)
@@ -176,6 +183,30 @@ struct tcp_sack_s
   uint32_t right;   /* Right edge of the SACK */
 };
 
+#ifdef CONFIG_NET_TCP_CC_NEWRENO
+/* A congestion control algorithm.  Slow start, fast retransmit and fast
+ * recovery are common to all algorithms, they only differ in how the
+ * window shrinks on a loss and how it grows in congestion avoidance.
+ */
+
+struct tcp_cc_ops_s
+{
+  FAR const char *name;
+
+  /* Reset the private state of the algorithm.  May be NULL. */
+
+  CODE void (*init)(FAR struct tcp_conn_s *conn);
+
+  /* Return the new slow start threshold after a loss */
+
+  CODE uint32_t (*ssthresh)(FAR struct tcp_conn_s *conn);
+
+  /* Grow cwnd in congestion avoidance, 'acked' bytes were just ACKed */
+
+  CODE void (*cong_avoid)(FAR struct tcp_conn_s *conn, uint32_t acked);
+};
+#endif
+
 struct tcp_conn_s
 {
   /* Common prologue of all connection structures. */
@@ -209,6 +240,8 @@ struct tcp_conn_s
   /* TCP-specific content follows */
 
   union ip_binding_u u;   /* IP address binding */
+  hash_node_t hnode;      /* Link in the hashtable of active connections */
+  hash_node_t lnode;      /* Link in the hashtable of listeners */
   uint8_t  rcvseq[4];     /* The sequence number that we expect to
                            * receive next */
   uint8_t  sndseq[4];     /* The sequence number that was last sent by us */
@@ -252,6 +285,15 @@ struct tcp_conn_s
   uint32_t cwnd;          /* The Congestion window */
   uint32_t max_cwnd;      /* The Congestion window maximum value */
   uint32_t ssthresh;      /* The Slow start threshold */
+
+  FAR const struct tcp_cc_ops_s *cc_ops; /* Congestion control algorithm */
+#endif
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+  clock_t  cubic_epoch;   /* Start of the current epoch, 0 if none */
+  uint32_t cubic_k;       /* Time to reach cubic_wmax (units: ms) */
+  uint32_t cubic_wmax;    /* cwnd before the last reduction */
+  uint32_t cubic_origin;  /* cwnd at the plateau of the cubic function */
+  uint32_t cubic_west;    /* Window of an equivalent Reno flow */
 #endif
 #ifdef CONFIG_NET_TCP_WINDOW_SCALE
   uint32_t snd_wnd;       /* Sequence and acknowledgement numbers of last
@@ -328,6 +370,18 @@ struct tcp_conn_s
                            * segment (next greater sndseq) */
 #endif
 
+#ifdef CONFIG_NET_TCP_ZEROCOPY
+  /* Zero-copy send
+   *
+   *   zc_id   - The number of the next MSG_ZEROCOPY send call.
+   *   zc_errq - Completed send calls not yet read with MSG_ERRQUEUE,
+   *             contiguous calls are merged into one entry.
+   */
+
+  uint32_t   zc_id;
+  sq_queue_t zc_errq;
+#endif
+
 #ifdef CONFIG_NET_TCPBACKLOG
   /* Listen backlog support
    *
@@ -403,6 +457,23 @@ struct tcp_conn_s
 
 /* This structure supports TCP write buffering */
 
+#ifdef CONFIG_NET_TCP_ZEROCOPY
+/* This structure tracks one MSG_ZEROCOPY send call.  It is referenced by
+ * every write buffer holding its data and, once all of them have been
+ * released, it is queued in zc_errq of the connection as a completion.
+ */
+
+struct tcp_zcopy_s
+{
+  sq_entry_t zc_node;              /* Supports a singly linked list */
+  FAR struct tcp_conn_s *zc_conn;  /* The connection of the send call */
+  uint32_t   zc_lo;                /* First completed send call */
+  uint32_t   zc_hi;                /* Last completed send call */
+  uint16_t   zc_refs;              /* References from the write buffers */
+  bool       zc_queued;            /* Some data has been queued */
+};
+#endif
+
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
 struct tcp_wrbuffer_s
 {
@@ -415,6 +486,9 @@ struct tcp_wrbuffer_s
   uint8_t    wb_nack;      /* The number of ack count */
 #endif
   struct iob_s *wb_iob;    /* Head of the I/O buffer chain */
+#ifdef CONFIG_NET_TCP_ZEROCOPY
+  FAR struct tcp_zcopy_s *wb_zcopy; /* Zero-copy send referencing the data */
+#endif
 };
 #endif
 
@@ -455,6 +529,12 @@ extern "C"
 {
 #endif
 
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+/* The CUBIC congestion control algorithm, see tcp_cc_cubic.c */
+
+extern const struct tcp_cc_ops_s g_tcp_cc_cubic;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -1880,6 +1960,98 @@ uint32_t tcp_wrbuffer_inqueue_size(FAR struct tcp_conn_s *conn);
 int tcp_wrbuffer_test(void);
 #endif /* CONFIG_NET_TCP_WRITE_BUFFERS */
 
+/****************************************************************************
+ * Name: tcp_zcopy_alloc
+ *
+ * Description:
+ *   Start a MSG_ZEROCOPY send call on the connection.  The returned
+ *   reference is dropped with tcp_zcopy_done() when the call returns.
+ *
+ * Returned Value:
+ *   The zero-copy send call or NULL if out of memory.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_ZEROCOPY
+FAR struct tcp_zcopy_s *tcp_zcopy_alloc(FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Name: tcp_zcopy_put
+ *
+ * Description:
+ *   Drop a reference to a zero-copy send call.  The last reference queues
+ *   its completion on the error queue of the connection.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+void tcp_zcopy_put(FAR struct tcp_zcopy_s *zc);
+
+/****************************************************************************
+ * Name: tcp_zcopy_done
+ *
+ * Description:
+ *   End a MSG_ZEROCOPY send call and drop the reference of the caller.  If
+ *   no data was queued, no completion is reported.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+void tcp_zcopy_done(FAR struct tcp_zcopy_s *zc);
+
+/****************************************************************************
+ * Name: tcp_zcopy_append
+ *
+ * Description:
+ *   Append user data to a write buffer without copying it.
+ *
+ * Returned Value:
+ *   The number of bytes appended (len) or -ENOMEM.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+int tcp_zcopy_append(FAR struct tcp_wrbuffer_s *wrb,
+                     FAR struct tcp_zcopy_s *zc,
+                     FAR const uint8_t *buf, size_t len);
+
+/****************************************************************************
+ * Name: tcp_zcopy_recverr
+ *
+ * Description:
+ *   Read the oldest zero-copy completion with recvmsg(MSG_ERRQUEUE).
+ *
+ * Returned Value:
+ *   Zero on success, -EAGAIN if no completion is pending.
+ *
+ ****************************************************************************/
+
+ssize_t tcp_zcopy_recverr(FAR struct tcp_conn_s *conn,
+                          FAR struct msghdr *msg);
+
+/****************************************************************************
+ * Name: tcp_zcopy_free
+ *
+ * Description:
+ *   Discard all pending completions of a connection being freed.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+void tcp_zcopy_free(FAR struct tcp_conn_s *conn);
+#endif
+
 /****************************************************************************
  * Name: tcp_event_handler_dump
  *
@@ -2308,6 +2480,54 @@ void tcp_cc_update(FAR struct tcp_conn_s *conn, FAR struct tcp_hdr_s *tcp);
  ****************************************************************************/
 
 void tcp_cc_recv_ack(FAR struct tcp_conn_s *conn, FAR struct tcp_hdr_s *tcp);
+
+/****************************************************************************
+ * Name: tcp_cc_timeout
+ *
+ * Description:
+ *   Update the congestion control variables after a retransmission
+ *   time-out.  The connection goes back to slow start.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_timeout(FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Name: tcp_cc_select
+ *
+ * Description:
+ *   Select the congestion control algorithm of a connection by name.  This
+ *   implements the TCP_CONGESTION socket option.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *   name   - The name of the algorithm, e.g. "newreno" or "cubic"
+ *
+ * Returned Value:
+ *   OK on success; -ENOENT if there is no algorithm of that name.
+ *
+ ****************************************************************************/
+
+int tcp_cc_select(FAR struct tcp_conn_s *conn, FAR const char *name);
+
+/****************************************************************************
+ * Name: tcp_cc_name
+ *
+ * Description:
+ *   Return the name of the congestion control algorithm of a connection.
+ *
+ ****************************************************************************/
+
+FAR const char *tcp_cc_name(FAR struct tcp_conn_s *conn);
 #endif
 
 #ifdef __cplusplus
@@ -24,8 +24,12 @@
  * Included Files
  ****************************************************************************/
 
+#include <string.h>
+#include <errno.h>
 #include <debug.h>
 
+#include <nuttx/net/net.h>
+
 #include "tcp/tcp.h"
 
 /****************************************************************************
@@ -74,10 +78,90 @@
     } \
  } while(0)
 
+#ifdef CONFIG_NET_TCP_CC_CUBIC_DEFAULT
+#  define TCP_CC_DEFAULT (&g_tcp_cc_cubic)
+#else
+#  define TCP_CC_DEFAULT (&g_tcp_cc_newreno)
+#endif
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static uint32_t tcp_newreno_ssthresh(FAR struct tcp_conn_s *conn);
+static void tcp_newreno_cong_avoid(FAR struct tcp_conn_s *conn,
+                                   uint32_t acked);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct tcp_cc_ops_s g_tcp_cc_newreno =
+{
+  "newreno",                /* name */
+  NULL,                     /* init */
+  tcp_newreno_ssthresh,     /* ssthresh */
+  tcp_newreno_cong_avoid    /* cong_avoid */
+};
+
+/* All algorithms that may be selected with TCP_CONGESTION */
+
+static FAR const struct tcp_cc_ops_s * const g_tcp_cc_algos[] =
+{
+  &g_tcp_cc_newreno,
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+  &g_tcp_cc_cubic,
+#endif
+};
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_newreno_ssthresh
+ *
+ * Description:
+ *   ssthresh = max (FlightSize / 2, 2*SMSS) referring to rfc5681
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_newreno_ssthresh(FAR struct tcp_conn_s *conn)
+{
+  return MAX(conn->tx_unacked / 2, 2 * conn->mss);
+}
+
+/****************************************************************************
+ * Name: tcp_newreno_cong_avoid
+ *
+ * Description:
+ *   Grow cwnd linearly by approximately maxseg per RTT using maxseg^2 / cwnd
+ *   per ACK as the increment (RFC 5681).  If cwnd > maxseg^2, fix the cwnd
+ *   increment at 1 byte to avoid capping cwnd.
+ *
+ ****************************************************************************/
+
+static void tcp_newreno_cong_avoid(FAR struct tcp_conn_s *conn,
+                                   uint32_t acked)
+{
+  uint32_t increase = MAX((conn->mss * conn->mss / conn->cwnd), 1);
+
+  CC_CWND_INC(conn->cwnd, increase);
+}
+
+/****************************************************************************
+ * Name: tcp_cc_ops
+ *
+ * Description:
+ *   Return the congestion control algorithm of a connection.
+ *
+ ****************************************************************************/
+
+static FAR const struct tcp_cc_ops_s *tcp_cc_ops(FAR struct tcp_conn_s *conn)
+{
+  return conn->cc_ops != NULL ? conn->cc_ops : TCP_CC_DEFAULT;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -103,6 +187,8 @@
 
 void tcp_cc_init(FAR struct tcp_conn_s *conn)
 {
+  FAR const struct tcp_cc_ops_s *ops = tcp_cc_ops(conn);
+
   CC_INIT_CWND(conn->cwnd, conn->mss);
 
   /* RFC 5681 recommends setting ssthresh arbitrarily high and
@@ -117,6 +203,12 @@ void tcp_cc_init(FAR struct tcp_conn_s *conn)
 
   conn->ssthresh = 2 * TCP_IPV4_DEFAULT_MSS;
   conn->dupacks = 0;
+  conn->cc_ops = ops;
+
+  if (ops->init != NULL)
+    {
+      ops->init(conn);
+    }
 }
 
 /****************************************************************************
@@ -140,15 +232,14 @@ void tcp_cc_init(FAR struct tcp_conn_s *conn)
 
 void tcp_cc_update(FAR struct tcp_conn_s *conn, FAR struct tcp_hdr_s *tcp)
 {
-  /* After Fast retransmitted, set ssthresh to the maximum of
-   * the unacked and the 2*SMSS, and enter to Fast Recovery.
-   * ssthresh = max (FlightSize / 2, 2*SMSS) referring to rfc5681
+  /* After Fast retransmitted, let the algorithm reduce ssthresh and enter
+   * to Fast Recovery.
    * cwnd=ssthresh + 3*SMSS  referring to rfc5681
    */
 
   if (conn->flags & TCP_INFT)
     {
-      conn->ssthresh = MAX(conn->tx_unacked / 2, 2 * conn->mss);
+      conn->ssthresh = tcp_cc_ops(conn)->ssthresh(conn);
       conn->cwnd = conn->ssthresh + 3 * conn->mss;
 
       conn->flags &= ~TCP_INFT;
@@ -284,19 +375,104 @@ void tcp_cc_recv_ack(FAR struct tcp_conn_s *conn, FAR struct tcp_hdr_s *tcp)
             }
           else
             {
-              /* cong avoid (RFC 5681):
-               * Grow cwnd linearly by approximately maxseg per RTT using
-               * maxseg^2 / cwnd per ACK as the increment.
-               * If cwnd > maxseg^2, fix the cwnd increment at 1 byte to
-               * avoid capping cwnd.
-               */
+              /* cong avoid, the growth depends on the algorithm */
 
-              increase = MAX((conn->mss * conn->mss / conn->cwnd), 1);
-
-              CC_CWND_INC(conn->cwnd, increase);
+              tcp_cc_ops(conn)->cong_avoid(conn, acked);
               conn->cwnd = MIN(conn->cwnd, conn->max_cwnd);
               ninfo("update congestion avoidance cwnd to %u\n", conn->cwnd);
             }
         }
     }
 }
+
+/****************************************************************************
+ * Name: tcp_cc_timeout
+ *
+ * Description:
+ *   Update the congestion control variables after a retransmission
+ *   time-out.  The connection goes back to slow start.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_timeout(FAR struct tcp_conn_s *conn)
+{
+  /* If conn is TCP_INFR, it should enter to slow start */
+
+  conn->flags &= ~TCP_INFR;
+
+  /* update the max_cwnd */
+
+  conn->max_cwnd = (conn->max_cwnd + 7 * conn->cwnd) >> 3;
+
+  /* reset cwnd and ssthresh, refers to RFC5861. */
+
+  conn->ssthresh = tcp_cc_ops(conn)->ssthresh(conn);
+  conn->cwnd = conn->mss;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_select
+ *
+ * Description:
+ *   Select the congestion control algorithm of a connection by name.  This
+ *   implements the TCP_CONGESTION socket option.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *   name   - The name of the algorithm, e.g. "newreno" or "cubic"
+ *
+ * Returned Value:
+ *   OK on success; -ENOENT if there is no algorithm of that name.
+ *
+ ****************************************************************************/
+
+int tcp_cc_select(FAR struct tcp_conn_s *conn, FAR const char *name)
+{
+  FAR const struct tcp_cc_ops_s *ops;
+  int i;
+
+  for (i = 0; i < nitems(g_tcp_cc_algos); i++)
+    {
+      ops = g_tcp_cc_algos[i];
+      if (strcmp(ops->name, name) == 0)
+        {
+          /* The window is kept, only the private state of the new
+           * algorithm starts from scratch.
+           */
+
+          net_lock();
+          conn->cc_ops = ops;
+          if (ops->init != NULL)
+            {
+              ops->init(conn);
+            }
+
+          net_unlock();
+          return OK;
+        }
+    }
+
+  return -ENOENT;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_name
+ *
+ * Description:
+ *   Return the name of the congestion control algorithm of a connection.
+ *
+ ****************************************************************************/
+
+FAR const char *tcp_cc_name(FAR struct tcp_conn_s *conn)
+{
+  return tcp_cc_ops(conn)->name;
+}
@@ -0,0 +1,265 @@
+/****************************************************************************
+ * net/tcp/tcp_cc_cubic.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+
+#include "tcp/tcp.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* RFC 9438 uses beta_cubic = 0.7 and C = 0.4.  All windows are kept in
+ * bytes and all times in milliseconds.
+ *
+ *   W_cubic(t) = C * (t - K)^3 + W_max           (segments, seconds)
+ *   K          = cbrt((W_max - cwnd_epoch) / C)
+ *
+ * so that in bytes and milliseconds
+ *
+ *   W_cubic(t) = W_max + 4 * MSS * (t - K)^3 / 10^10
+ *   K          = cbrt((W_max - cwnd_epoch) / MSS * 2.5 * 10^9)
+ */
+
+#define CUBIC_BETA_NUM       7     /* beta_cubic = 7 / 10 */
+#define CUBIC_BETA_DEN       10
+
+/* Fast convergence: W_max = cwnd * (1 + beta_cubic) / 2 */
+
+#define CUBIC_FC_NUM         17
+#define CUBIC_FC_DEN         20
+
+/* Reno-friendly region: alpha_cubic = 3 * (1 - beta) / (1 + beta) */
+
+#define CUBIC_ALPHA_NUM      9
+#define CUBIC_ALPHA_DEN      17
+
+/* |t - K| is limited so that its cube times 4 * MSS fits in 64 bits.  The
+ * target is limited to 1.5 * cwnd long before that.
+ */
+
+#define CUBIC_TIME_MAX       (1 << 18)
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void tcp_cubic_init(FAR struct tcp_conn_s *conn);
+static uint32_t tcp_cubic_ssthresh(FAR struct tcp_conn_s *conn);
+static void tcp_cubic_cong_avoid(FAR struct tcp_conn_s *conn,
+                                 uint32_t acked);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct tcp_cc_ops_s g_tcp_cc_cubic =
+{
+  "cubic",                  /* name */
+  tcp_cubic_init,           /* init */
+  tcp_cubic_ssthresh,       /* ssthresh */
+  tcp_cubic_cong_avoid      /* cong_avoid */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_cubic_cbrt
+ *
+ * Description:
+ *   Return the integer cube root of 'x', rounded down.
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_cubic_cbrt(uint64_t x)
+{
+  uint64_t y = 0;
+  uint64_t b;
+  int s;
+
+  for (s = 63; s >= 0; s -= 3)
+    {
+      y <<= 1;
+      b = 3 * y * (y + 1) + 1;
+      if ((x >> s) >= b)
+        {
+          x -= b << s;
+          y++;
+        }
+    }
+
+  return (uint32_t)y;
+}
+
+/****************************************************************************
+ * Name: tcp_cubic_rtt
+ *
+ * Description:
+ *   Return the smoothed round trip time in milliseconds.  The estimate of
+ *   the retransmission timer only has a resolution of half a second.
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_cubic_rtt(FAR struct tcp_conn_s *conn)
+{
+  return (uint32_t)(conn->sa >> 3) * MSEC_PER_HSEC;
+}
+
+/****************************************************************************
+ * Name: tcp_cubic_init
+ *
+ * Description:
+ *   Forget all congestion events.
+ *
+ ****************************************************************************/
+
+static void tcp_cubic_init(FAR struct tcp_conn_s *conn)
+{
+  conn->cubic_epoch  = 0;
+  conn->cubic_k      = 0;
+  conn->cubic_wmax   = 0;
+  conn->cubic_origin = 0;
+  conn->cubic_west   = 0;
+}
+
+/****************************************************************************
+ * Name: tcp_cubic_ssthresh
+ *
+ * Description:
+ *   A congestion event ends the current epoch.  Remember the window at
+ *   which it happened and reduce the window by beta_cubic.
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_cubic_ssthresh(FAR struct tcp_conn_s *conn)
+{
+  uint32_t cwnd = conn->cwnd;
+
+  conn->cubic_epoch = 0;
+
+  /* Fast convergence: if the window did not get back to the last maximum,
+   * another flow is probably taking over, so give it some room.
+   */
+
+  if (cwnd < conn->cubic_wmax)
+    {
+      conn->cubic_wmax = (uint64_t)cwnd * CUBIC_FC_NUM / CUBIC_FC_DEN;
+    }
+  else
+    {
+      conn->cubic_wmax = cwnd;
+    }
+
+  return MAX((uint64_t)cwnd * CUBIC_BETA_NUM / CUBIC_BETA_DEN,
+             2 * conn->mss);
+}
+
+/****************************************************************************
+ * Name: tcp_cubic_cong_avoid
+ *
+ * Description:
+ *   Move cwnd towards the cubic function evaluated one round trip time
+ *   ahead, or towards the window of a Reno flow if that is larger.
+ *
+ ****************************************************************************/
+
+static void tcp_cubic_cong_avoid(FAR struct tcp_conn_s *conn,
+                                 uint32_t acked)
+{
+  clock_t now = clock_systime_ticks();
+  uint32_t cwnd = conn->cwnd;
+  uint32_t mss = conn->mss;
+  uint64_t target;
+  uint64_t delta;
+  uint32_t offs;
+  uint32_t t;
+
+  if (conn->cubic_epoch == 0)
+    {
+      /* Start a new epoch, the clock value 0 means no epoch */
+
+      conn->cubic_epoch = now != 0 ? now : 1;
+      conn->cubic_west  = cwnd;
+
+      if (cwnd < conn->cubic_wmax)
+        {
+          delta = (uint64_t)(conn->cubic_wmax - cwnd) * 2500000 / mss;
+          conn->cubic_k      = tcp_cubic_cbrt(delta * 1000);
+          conn->cubic_origin = conn->cubic_wmax;
+        }
+      else
+        {
+          conn->cubic_k      = 0;
+          conn->cubic_origin = cwnd;
+        }
+    }
+
+  t    = TICK2MSEC(now - conn->cubic_epoch) + tcp_cubic_rtt(conn);
+  offs = t > conn->cubic_k ? t - conn->cubic_k : conn->cubic_k - t;
+  offs = MIN(offs, CUBIC_TIME_MAX);
+
+  delta = (uint64_t)offs * offs * offs / 10000 * 4 * mss / 1000000;
+
+  if (t > conn->cubic_k)
+    {
+      target = conn->cubic_origin + delta;
+    }
+  else
+    {
+      target = conn->cubic_origin > delta ?
+               conn->cubic_origin - delta : 0;
+    }
+
+  /* Never grow slower than Reno would */
+
+  delta = conn->cubic_west + (uint64_t)acked * mss * CUBIC_ALPHA_NUM /
+                             ((uint64_t)cwnd * CUBIC_ALPHA_DEN);
+  conn->cubic_west = (uint32_t)MIN(delta, UINT32_MAX);
+  if (conn->cubic_west > target)
+    {
+      target = conn->cubic_west;
+    }
+
+  /* cwnd grows by (target - cwnd) / cwnd per segment ACKed */
+
+  target = MIN(target, (uint64_t)cwnd + cwnd / 2);
+  if (target > cwnd)
+    {
+      delta = (target - cwnd) * acked / cwnd;
+      conn->cwnd = (uint32_t)MIN(cwnd + delta, UINT32_MAX);
+    }
+
+  ninfo("cubic: t %" PRIu32 " K %" PRIu32 " cwnd %" PRIu32 "\n",
+        t, conn->cubic_k, conn->cwnd);
+}
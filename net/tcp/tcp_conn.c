@@ -57,6 +57,7 @@
 #include <arch/irq.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/hashtable.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/net.h>
@@ -95,10 +96,74 @@ NET_BUFPOOL_DECLARE(g_tcp_connections, sizeof(struct tcp_conn_s),
 
 static dq_queue_t g_active_tcp_connections;
 
+/* The same connections, hashed by remote address and ports */
+
+static DECLARE_HASHTABLE(g_tcp_active_hash, CONFIG_NET_TCP_HASH_BITS);
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_hash_key
+ *
+ * Description:
+ *   Create the hash key of an active connection.  The local address is left
+ *   out because a connection may be bound to INADDR_ANY.
+ *
+ ****************************************************************************/
+
+static inline uint32_t tcp_hash_key(in_addr_t raddr, uint16_t rport,
+                                    uint16_t lport)
+{
+  return NTOHL(raddr) ^ ((uint32_t)rport << 16) ^ lport;
+}
+
+/****************************************************************************
+ * Name: tcp_conn_key
+ *
+ * Description:
+ *   Return the hash key of an active connection.  For IPv6 only the low
+ *   32 bits of the remote address are used.
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_conn_key(FAR struct tcp_conn_s *conn)
+{
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (conn->domain == PF_INET6)
+#endif
+    {
+      return tcp_hash_key(net_ip4addr_conv32(&conn->u.ipv6.raddr[6]),
+                          conn->rport, conn->lport);
+    }
+#endif /* CONFIG_NET_IPv6 */
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      return tcp_hash_key(conn->u.ipv4.raddr, conn->rport, conn->lport);
+    }
+#endif /* CONFIG_NET_IPv4 */
+}
+
+/****************************************************************************
+ * Name: tcp_activate
+ *
+ * Description:
+ *   Put a connection into the list and the hashtable of active connections.
+ *
+ ****************************************************************************/
+
+static void tcp_activate(FAR struct tcp_conn_s *conn)
+{
+  dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
+  hashtable_add(g_tcp_active_hash, &conn->hnode, tcp_conn_key(conn));
+}
+
 /****************************************************************************
  * Name: tcp_listener
  *
@@ -192,15 +257,18 @@ static inline FAR struct tcp_conn_s *
 {
   FAR struct ipv4_hdr_s *ip = IPv4BUF;
   FAR struct tcp_conn_s *conn;
+  FAR hash_node_t *p;
   in_addr_t srcipaddr;
   in_addr_t destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = net_ip4addr_conv32(ip->srcipaddr);
   destipaddr = net_ip4addr_conv32(ip->destipaddr);
 
-  while (conn)
+  hashtable_for_every_possible(g_tcp_active_hash, p,
+                    tcp_hash_key(srcipaddr, tcp->srcport, tcp->destport))
     {
+      conn = container_of(p, struct tcp_conn_s, hnode);
+
       /* Find an open connection matching the TCP input. The following
        * checks are performed:
        *
@@ -225,19 +293,13 @@ static inline FAR struct tcp_conn_s *
            net_ipv4addr_cmp(destipaddr, conn->u.ipv4.laddr)) &&
           net_ipv4addr_cmp(srcipaddr, conn->u.ipv4.raddr))
         {
-          /* Matching connection found.. break out of the loop and return a
-           * reference to it.
-           */
+          /* Matching connection found.. return a reference to it. */
 
-          break;
+          return conn;
         }
-
-      /* Look at the next active connection */
-
-      conn = (FAR struct tcp_conn_s *)conn->sconn.node.flink;
     }
 
-  return conn;
+  return NULL;
 }
 #endif /* CONFIG_NET_IPv4 */
 
@@ -259,15 +321,19 @@ static inline FAR struct tcp_conn_s *
 {
   FAR struct ipv6_hdr_s *ip = IPv6BUF;
   FAR struct tcp_conn_s *conn;
+  FAR hash_node_t *p;
   net_ipv6addr_t *srcipaddr;
   net_ipv6addr_t *destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = (net_ipv6addr_t *)ip->srcipaddr;
   destipaddr = (net_ipv6addr_t *)ip->destipaddr;
 
-  while (conn)
+  hashtable_for_every_possible(g_tcp_active_hash, p,
+                    tcp_hash_key(net_ip4addr_conv32(&ip->srcipaddr[6]),
+                                 tcp->srcport, tcp->destport))
     {
+      conn = container_of(p, struct tcp_conn_s, hnode);
+
       /* Find an open connection matching the TCP input. The following
        * checks are performed:
        *
@@ -292,19 +358,13 @@ static inline FAR struct tcp_conn_s *
            net_ipv6addr_cmp(*destipaddr, conn->u.ipv6.laddr)) &&
           net_ipv6addr_cmp(*srcipaddr, conn->u.ipv6.raddr))
         {
-          /* Matching connection found.. break out of the loop and return a
-           * reference to it.
-           */
+          /* Matching connection found.. return a reference to it. */
 
-          break;
+          return conn;
         }
-
-      /* Look at the next active connection */
-
-      conn = (FAR struct tcp_conn_s *)conn->sconn.node.flink;
     }
 
-  return conn;
+  return NULL;
 }
 #endif /* CONFIG_NET_IPv6 */
 
@@ -608,6 +668,7 @@ int tcp_selectport(uint8_t domain,
 
 void tcp_initialize(void)
 {
+  hashtable_init(g_tcp_active_hash);
 }
 
 /****************************************************************************
@@ -737,6 +798,9 @@ FAR struct tcp_conn_s *tcp_alloc(uint8_t domain)
 
       nxsem_init(&conn->snd_sem, 0, 0);
 #endif
+#ifdef CONFIG_NET_CONN_LOCK
+      nxmutex_init(&conn->sconn.s_lock);
+#endif
 
       /* Set the default value of mss to max, this field will changed when
        * receive SYN.
@@ -776,8 +840,10 @@ void tcp_free_rx_buffers(FAR struct tcp_conn_s *conn)
 {
   /* Release any read-ahead buffers attached to the connection */
 
+  conn_lock(&conn->sconn);
   iob_free_chain(conn->readahead);
   conn->readahead = NULL;
+  conn_unlock(&conn->sconn);
 
 #ifdef CONFIG_NET_TCP_OUT_OF_ORDER
   /* Release any out-of-order buffers */
@@ -860,6 +926,8 @@ void tcp_free(FAR struct tcp_conn_s *conn)
       /* Remove the connection from the active list */
 
       dq_rem(&conn->sconn.node, &g_active_tcp_connections);
+      hashtable_delete(g_tcp_active_hash, &conn->hnode,
+                       tcp_conn_key(conn));
     }
 
   tcp_free_rx_buffers(conn);
@@ -879,6 +947,12 @@ void tcp_free(FAR struct tcp_conn_s *conn)
       tcp_wrbuffer_release(wrbuffer);
     }
 
+#ifdef CONFIG_NET_TCP_ZEROCOPY
+  /* Discard the zero-copy completions not read by the application */
+
+  tcp_zcopy_free(conn);
+#endif
+
 #if CONFIG_NET_SEND_BUFSIZE > 0
   /* Notify the send buffer available */
 
@@ -909,6 +983,10 @@ void tcp_free(FAR struct tcp_conn_s *conn)
 
   conn->tcpstateflags = TCP_CLOSED;
 
+#ifdef CONFIG_NET_CONN_LOCK
+  nxmutex_destroy(&conn->sconn.s_lock);
+#endif
+
   /* Free the connection structure */
 
   NET_BUFPOOL_FREE(g_tcp_connections, conn);
@@ -1131,8 +1209,11 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
 #endif
 
 #ifdef CONFIG_NET_TCP_CC_NEWRENO
-      /* Initialize the variables of congestion control */
+      /* Initialize the variables of congestion control, the algorithm is
+       * inherited from the listener.
+       */
 
+      conn->cc_ops = listener->cc_ops;
       tcp_cc_init(conn);
 #endif
 
@@ -1152,11 +1233,16 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
       sq_init(&conn->unacked_q);
 #endif
 
+#ifdef CONFIG_NET_TCP_ZEROCOPY
+      conn->zc_id = 0;
+      sq_init(&conn->zc_errq);
+#endif
+
       /* And, finally, put the connection structure into the active list.
        * Interrupts should already be disabled in this context.
        */
 
-      dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
+      tcp_activate(conn);
       tcp_update_retrantimer(conn, TCP_RTO);
     }
 
@@ -1465,9 +1551,14 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
   sq_init(&conn->unacked_q);
 #endif
 
+#ifdef CONFIG_NET_TCP_ZEROCOPY
+  conn->zc_id = 0;
+  sq_init(&conn->zc_errq);
+#endif
+
   /* And, finally, put the connection structure into the active list. */
 
-  dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
+  tcp_activate(conn);
   ret = OK;
 
 errout_with_lock:
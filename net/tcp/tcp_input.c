@@ -724,9 +724,11 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
   tcpiplen = iplen + TCP_HDRLEN;
 
 #ifdef CONFIG_NET_TCP_CHECKSUMS
-  /* Start of TCP input header processing code. */
+  /* Start of TCP input header processing code.  The checksum is only
+   * computed if the device did not verify it already.
+   */
 
-  if (tcp_chksum(dev) != 0xffff)
+  if (!NETDEV_RX_CSUM_VALID(dev) && tcp_chksum(dev) != 0xffff)
     {
       /* Compute and check the TCP checksum. */
 
@@ -65,6 +65,7 @@ static void tcp_path(FAR struct tcp_conn_s *conn, FAR char *buf, size_t len)
   FAR void *laddr = net_ip_binding_laddr(&conn->u, domain);
   FAR void *raddr = net_ip_binding_raddr(&conn->u, domain);
 
+  conn_lock(&conn->sconn);
   snprintf(buf, len, "tcp:["
            "%s:%" PRIu16 "<->%s:%" PRIu16
 #if CONFIG_NET_SEND_BUFSIZE > 0
@@ -97,6 +98,7 @@ static void tcp_path(FAR struct tcp_conn_s *conn, FAR char *buf, size_t len)
            conn->tcpstateflags,
            conn->sconn.s_flags
            );
+  conn_unlock(&conn->sconn);
 }
 
 /****************************************************************************
@@ -126,6 +128,7 @@ int tcp_ioctl(FAR struct tcp_conn_s *conn, int cmd, unsigned long arg)
   switch (cmd)
     {
       case FIONREAD:
+        conn_lock(&conn->sconn);
         if (conn->readahead != NULL)
           {
             *(FAR int *)((uintptr_t)arg) = conn->readahead->io_pktlen;
@@ -134,6 +137,8 @@ int tcp_ioctl(FAR struct tcp_conn_s *conn, int cmd, unsigned long arg)
           {
             *(FAR int *)((uintptr_t)arg) = 0;
           }
+
+        conn_unlock(&conn->sconn);
         break;
       case FIONSPACE:
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
@@ -159,6 +159,15 @@ static uint16_t tcp_poll_eventhandler(FAR struct net_driver_s *dev,
           eventset |= POLLOUT;
         }
 
+#ifdef CONFIG_NET_TCP_ZEROCOPY
+      /* Zero-copy send completions are reported as errors */
+
+      if (!sq_empty(&info->conn->zc_errq))
+        {
+          eventset |= POLLERR;
+        }
+#endif
+
       /* Awaken the caller of poll() if requested event occurred. */
 
       poll_notify(&info->fds, 1, eventset);
@@ -282,6 +291,17 @@ int tcp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
       cb->flags |= TCP_NEWDATA | TCP_BACKLOG;
     }
 
+#ifdef CONFIG_NET_TCP_ZEROCOPY
+  /* Zero-copy send completions are queued when the data is ACKed.  The
+   * periodic poll catches those queued after this handler has run.
+   */
+
+  if (_SO_GETOPT(conn->sconn.s_options, SO_ZEROCOPY))
+    {
+      cb->flags |= TCP_ACKDATA | TCP_POLL;
+    }
+#endif
+
   /* Save the reference in the poll info structure as fds private as well
    * for use during poll teardown as well.
    */
@@ -354,6 +374,13 @@ int tcp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
       eventset |= POLLWRNORM;
     }
 
+#ifdef CONFIG_NET_TCP_ZEROCOPY
+  if (!sq_empty(&conn->zc_errq))
+    {
+      eventset |= POLLERR;
+    }
+#endif
+
   /* Check if any requested events are already in effect */
 
   poll_notify(&fds, 1, eventset);
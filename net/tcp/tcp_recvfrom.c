@@ -236,7 +236,8 @@ static inline uint16_t tcp_newdata(FAR struct net_driver_s *dev,
  *   None
  *
  * Assumptions:
- *   The network is locked.
+ *   The network may or may not be locked; the read-ahead buffers are
+ *   protected by the lock of the connection.
  *
  ****************************************************************************/
 
@@ -250,6 +251,7 @@ static inline void tcp_readahead(struct tcp_recvfrom_s *pstate)
    * buffer.
    */
 
+  conn_lock(&conn->sconn);
   while ((iob = conn->readahead) != NULL &&
           pstate->ir_buflen > 0)
     {
@@ -297,6 +299,8 @@ static inline void tcp_readahead(struct tcp_recvfrom_s *pstate)
           conn->readahead = iob_trimhead(iob, recvlen);
         }
     }
+
+  conn_unlock(&conn->sconn);
 }
 
 /****************************************************************************
@@ -880,9 +884,50 @@ ssize_t psock_tcp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
   ssize_t                ret     = 0;
   int                    i;
 
+  conn = psock->s_conn;
+
+#ifdef CONFIG_NET_TCP_ZEROCOPY
+  /* The error queue only holds the zero-copy send completions */
+
+  if ((flags & MSG_ERRQUEUE) != 0)
+    {
+      return tcp_zcopy_recverr(conn, msg);
+    }
+#endif
+
+#ifdef CONFIG_NET_CONN_LOCK
+  /* Data that is already buffered is copied out under the lock of the
+   * connection only.  The network lock is taken afterwards just to update
+   * the receive window.
+   */
+
+  if (msg->msg_iovlen == 1 && (flags & MSG_WAITALL) == 0)
+    {
+      struct tcp_recvfrom_s state;
+
+      tcp_recvfrom_initialize(conn, msg->msg_iov[0].iov_base,
+                              msg->msg_iov[0].iov_len, from, fromlen,
+                              &state, flags);
+      tcp_readahead(&state);
+      tcp_recvfrom_uninitialize(&state);
+
+      if (state.ir_recvlen > 0)
+        {
+          net_lock();
+          if (tcp_should_send_recvwindow(conn))
+            {
+              netdev_txnotify_dev(conn->dev);
+            }
+
+          tcp_notify_recvcpu(conn);
+          net_unlock();
+          return state.ir_recvlen;
+        }
+    }
+#endif
+
   net_lock();
 
-  conn = psock->s_conn;
   for (i = 0; i < msg->msg_iovlen; i++)
     {
       FAR void *buf = msg->msg_iov[i].iov_base;
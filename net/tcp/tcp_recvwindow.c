@@ -65,7 +65,10 @@ static uint32_t tcp_calc_rcvsize(FAR struct tcp_conn_s *conn,
   uint32_t recvsize;
   uint32_t desire;
 
+  conn_lock(&conn->sconn);
   recvsize = conn->readahead ? conn->readahead->io_pktlen : 0;
+  conn_unlock(&conn->sconn);
+
   if (conn->rcv_bufs > recvsize)
     {
       desire = conn->rcv_bufs - recvsize;
@@ -147,6 +150,7 @@ uint32_t tcp_get_recvwindow(FAR struct net_driver_s *dev,
 {
   uint32_t tailroom;
   uint32_t recvwndo;
+  bool readahead;
   int niob_avail;
 
   /* Update the TCP received window based on read-ahead I/O buffer
@@ -154,9 +158,14 @@ uint32_t tcp_get_recvwindow(FAR struct net_driver_s *dev,
    * The amount of read-ahead
    * data that can be buffered is given by the number of IOBs available
    * (ignoring competition with other IOB consumers).
+   *
+   * recv() may trim the read-ahead buffers holding only the lock of the
+   * connection, so they must not be looked at without it.
    */
 
-  if (conn->readahead != NULL)
+  conn_lock(&conn->sconn);
+  readahead = conn->readahead != NULL;
+  if (readahead)
     {
       tailroom = iob_tailroom(conn->readahead);
     }
@@ -165,6 +174,8 @@ uint32_t tcp_get_recvwindow(FAR struct net_driver_s *dev,
       tailroom = 0;
     }
 
+  conn_unlock(&conn->sconn);
+
   niob_avail = iob_navail(true);
 
   /* Is there a a queue entry and IOBs available for read-ahead buffering? */
@@ -189,7 +200,7 @@ uint32_t tcp_get_recvwindow(FAR struct net_driver_s *dev,
       recvwndo = tailroom + (niob_avail * CONFIG_IOB_BUFSIZE);
     }
 #if CONFIG_IOB_THROTTLE > 0
-  else if (conn->readahead == NULL)
+  else if (!readahead)
     {
       /* Advertise maximum segment size for window edge if here is no
        * available iobs on current "free" connection.
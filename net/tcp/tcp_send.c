@@ -104,6 +104,94 @@ static inline FAR struct tcp_hdr_s *tcp_header(FAR struct net_driver_s *dev)
 #endif /* CONFIG_NET_IPv4 */
 }
 
+/****************************************************************************
+ * Name: tcp_offload
+ *
+ * Description:
+ *   Fill in the offload metadata of an outgoing segment.  A segment with
+ *   more payload than the MSS is cut into MSS sized segments by the device
+ *   or by the upper half driver.
+ *
+ * Input Parameters:
+ *   dev  - The device driver structure to use in the send operation
+ *   conn - The TCP connection structure holding connection information
+ *   tcp  - The TCP header of the segment, after the IP header is built
+ *
+ * Returned Value:
+ *   True if the device computes the TCP checksum.  The checksum field then
+ *   holds the checksum of the pseudo header.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_OFFLOAD
+static bool tcp_offload(FAR struct net_driver_s *dev,
+                        FAR struct tcp_conn_s *conn,
+                        FAR struct tcp_hdr_s *tcp)
+{
+  FAR struct iob_s *iob = dev->d_iob;
+  unsigned int iplen;
+  uint16_t sum;
+  uint8_t gso;
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (IFF_IS_IPv6(dev->d_flags))
+#endif
+    {
+      iplen = IPv6_HDRLEN;
+      gso   = NETPKT_GSO_TCPV6;
+    }
+#endif /* CONFIG_NET_IPv6 */
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      iplen = IPv4_HDRLEN;
+      gso   = NETPKT_GSO_TCPV4;
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+  iob->io_offload = 0;
+
+  if (NETDEV_HAS_FEATURE(dev, NETDEV_F_GSO) &&
+      dev->d_len > iplen + ((tcp->tcpoffset >> 4) << 2) + conn->mss)
+    {
+      iob->io_offload = gso;
+      iob->io_gsosize = conn->mss;
+    }
+  else if (!NETDEV_HAS_FEATURE(dev, NETDEV_F_TXCSUM))
+    {
+      return false;
+    }
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (gso == NETPKT_GSO_TCPV6)
+#endif
+    {
+      sum = ipv6_upperlayer_header_chksum(dev, IP_PROTO_TCP, iplen);
+    }
+#endif /* CONFIG_NET_IPv6 */
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      sum = ipv4_upperlayer_header_chksum(dev, IP_PROTO_TCP);
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+  tcp->tcpchksum    = HTONS(sum);
+  iob->io_offload  |= NETPKT_CSUM_PARTIAL;
+  iob->io_csumstart = iplen;
+  iob->io_csumoff   = offsetof(struct tcp_hdr_s, tcpchksum);
+  return true;
+}
+#endif
+
 /****************************************************************************
  * Name: tcp_sendcommon
  *
@@ -195,14 +283,6 @@ static void tcp_sendcommon(FAR struct net_driver_s *dev,
                         conn->u.ipv6.raddr,
                         conn->sconn.s_ttl, conn->sconn.s_tclass);
 
-      /* Calculate TCP checksum. */
-
-      tcp->tcpchksum = 0;
-
-#ifdef CONFIG_NET_TCP_CHECKSUMS
-      tcp->tcpchksum = ~tcp_ipv6_chksum(dev);
-#endif
-
 #ifdef CONFIG_NET_STATISTICS
       g_netstats.ipv6.sent++;
 #endif
@@ -219,20 +299,25 @@ static void tcp_sendcommon(FAR struct net_driver_s *dev,
                         &dev->d_ipaddr, &conn->u.ipv4.raddr,
                         conn->sconn.s_ttl, conn->sconn.s_tos, NULL);
 
-      /* Calculate TCP checksum. */
-
-      tcp->tcpchksum = 0;
-
-#ifdef CONFIG_NET_TCP_CHECKSUMS
-      tcp->tcpchksum = ~tcp_ipv4_chksum(dev);
-#endif
-
 #ifdef CONFIG_NET_STATISTICS
       g_netstats.ipv4.sent++;
 #endif
     }
 #endif /* CONFIG_NET_IPv4 */
 
+  /* Calculate TCP checksum, or leave it to the device */
+
+  tcp->tcpchksum = 0;
+
+#ifdef CONFIG_NETDEV_OFFLOAD
+  if (!tcp_offload(dev, conn, tcp))
+#endif
+    {
+#ifdef CONFIG_NET_TCP_CHECKSUMS
+      tcp->tcpchksum = ~tcp_chksum(dev);
+#endif
+    }
+
   ninfo("Outgoing TCP packet length: %d bytes\n", dev->d_len);
 #ifdef CONFIG_NET_STATISTICS
   g_netstats.tcp.sent++;
@@ -485,6 +570,12 @@ void tcp_reset(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn)
 
   iob_update_pktlen(dev->d_iob, dev->d_len, false);
 
+#ifdef CONFIG_NETDEV_OFFLOAD
+  /* The reset is built in place of the received segment */
+
+  dev->d_iob->io_offload = 0;
+#endif
+
   /* Calculate chk & build L3 header */
 
 #ifdef CONFIG_NET_IPv6
@@ -411,6 +411,30 @@ static int parse_sack(FAR struct tcp_conn_s *conn, FAR struct tcp_hdr_s *tcp,
 }
 #endif /* CONFIG_NET_TCP_SELECTIVE_ACK */
 
+/****************************************************************************
+ * Name: tcp_send_maxlen
+ *
+ * Description:
+ *   Return the largest amount of new data to send in one packet.  A device
+ *   with segmentation offload takes several full sized segments at once.
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_send_maxlen(FAR struct net_driver_s *dev,
+                                FAR struct tcp_conn_s *conn)
+{
+#ifdef CONFIG_NETDEV_OFFLOAD
+  if (NETDEV_HAS_FEATURE(dev, NETDEV_F_GSO))
+    {
+      uint32_t maxlen = CONFIG_NETDEV_GSO_MAXSIZE - tcpip_hdrsize(conn);
+
+      return MAX(maxlen - maxlen % conn->mss, conn->mss);
+    }
+#endif
+
+  return conn->mss;
+}
+
 /****************************************************************************
  * Name: psock_send_eventhandler
  *
@@ -1040,9 +1064,9 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
           int ret;
 
           sndlen = TCP_WBPKTLEN(wrb) - TCP_WBSENT(wrb);
-          if (sndlen > conn->mss)
+          if (sndlen > tcp_send_maxlen(dev, conn))
             {
-              sndlen = conn->mss;
+              sndlen = tcp_send_maxlen(dev, conn);
             }
 
           remaining_snd_wnd = TCP_SEQ_SUB(snd_wnd_edge, seq);
@@ -1314,6 +1338,9 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
 {
   FAR struct tcp_conn_s *conn;
   FAR struct tcp_wrbuffer_s *wrb;
+#ifdef CONFIG_NET_TCP_ZEROCOPY
+  FAR struct tcp_zcopy_s *zcopy = NULL;
+#endif
   FAR const uint8_t *cp;
   unsigned int timeout;
   ssize_t    result = 0;
@@ -1378,6 +1405,20 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
 
   BUF_DUMP("psock_tcp_send", buf, len);
 
+#ifdef CONFIG_NET_TCP_ZEROCOPY
+  /* MSG_ZEROCOPY is ignored unless SO_ZEROCOPY was enabled on the socket.
+   * Without memory for the completion, fall back to copying the data.
+   */
+
+  if ((flags & MSG_ZEROCOPY) != 0 && len > 0 &&
+      _SO_GETOPT(conn->sconn.s_options, SO_ZEROCOPY))
+    {
+      net_lock();
+      zcopy = tcp_zcopy_alloc(conn);
+      net_unlock();
+    }
+#endif
+
   cp = buf;
   while (len > 0)
     {
@@ -1479,14 +1520,16 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
            * It makes sense to save the number of IOBs.)
            *
            * Also, for simplicity, do it only when we haven't sent anything
-           * from the the wrb yet.
+           * from the the wrb yet, and never into a wrb referencing the
+           * data of a zero-copy send.
            */
 
           max_wrb_size = tcp_max_wrb_size(conn);
           wrb = (FAR struct tcp_wrbuffer_s *)sq_tail(&conn->write_q);
           if (wrb != NULL && TCP_WBSENT(wrb) == 0 && TCP_WBNRTX(wrb) == 0 &&
               TCP_WBPKTLEN(wrb) < max_wrb_size &&
-              (TCP_WBPKTLEN(wrb) % conn->mss) != 0)
+              (TCP_WBPKTLEN(wrb) % conn->mss) != 0 &&
+              TCP_WBZCOPY(wrb) == NULL)
             {
               wrb = (FAR struct tcp_wrbuffer_s *)sq_remlast(&conn->write_q);
               ninfo("coalesce %zu bytes to wrb %p (%" PRIu16 ")\n", len, wrb,
@@ -1546,7 +1589,20 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
            * remaining data.
            */
 
-          chunk_result = TCP_WBTRYCOPYIN(wrb, cp, chunk_len, off);
+#ifdef CONFIG_NET_TCP_ZEROCOPY
+          if (zcopy != NULL)
+            {
+              /* Reference the user data instead of copying it */
+
+              chunk_len    = MIN(chunk_len, UINT16_MAX);
+              chunk_result = tcp_zcopy_append(wrb, zcopy, cp, chunk_len);
+            }
+          else
+#endif
+            {
+              chunk_result = TCP_WBTRYCOPYIN(wrb, cp, chunk_len, off);
+            }
+
           if (chunk_result == -ENOMEM)
             {
               if (TCP_WBPKTLEN(wrb) > 0)
@@ -1671,6 +1727,15 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
       goto errout;
     }
 
+#ifdef CONFIG_NET_TCP_ZEROCOPY
+  if (zcopy != NULL)
+    {
+      net_lock();
+      tcp_zcopy_done(zcopy);
+      net_unlock();
+    }
+#endif
+
   /* Return the number of bytes actually sent */
 
   return result;
@@ -1679,6 +1744,15 @@ errout_with_lock:
   net_unlock();
 
 errout:
+#ifdef CONFIG_NET_TCP_ZEROCOPY
+  if (zcopy != NULL)
+    {
+      net_lock();
+      tcp_zcopy_done(zcopy);
+      net_unlock();
+    }
+#endif
+
   if (result > 0)
     {
       return result;
@@ -73,6 +73,9 @@ struct sendfile_s
   FAR struct tcp_conn_s *snd_conn;         /* Connection associated with the socket */
   FAR struct devif_callback_s *snd_cb;     /* Reference to callback instance */
   FAR struct file   *snd_file;             /* File structure of the input file */
+#ifdef CONFIG_IOB_ALLOC
+  FAR const uint8_t *snd_xip;              /* File data addressable in memory */
+#endif
   sem_t              snd_sem;              /* Used to wake up the waiting thread */
   off_t              snd_foffset;          /* Input file offset */
   size_t             snd_flen;             /* File length */
@@ -96,6 +99,35 @@ struct sendfile_s
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: sendfile_send
+ *
+ * Description:
+ *   Set up the next packet with 'sndlen' bytes at 'offset' of the data to
+ *   send.
+ *
+ * Assumptions:
+ *   The network is locked
+ *
+ ****************************************************************************/
+
+static int sendfile_send(FAR struct net_driver_s *dev,
+                         FAR struct sendfile_s *pstate,
+                         uint32_t sndlen, uint32_t offset)
+{
+#ifdef CONFIG_IOB_ALLOC
+  if (pstate->snd_xip != NULL)
+    {
+      return devif_xip_send(dev, pstate->snd_xip + offset, sndlen,
+                            tcpip_hdrsize(pstate->snd_conn));
+    }
+#endif
+
+  return devif_file_send(dev, pstate->snd_file, sndlen,
+                         pstate->snd_foffset + offset,
+                         tcpip_hdrsize(pstate->snd_conn));
+}
+
 /****************************************************************************
  * Name: sendfile_eventhandler
  *
@@ -269,9 +301,7 @@ static uint16_t sendfile_eventhandler(FAR struct net_driver_s *dev,
        * happen until the polling cycle completes).
        */
 
-      ret = devif_file_send(dev, pstate->snd_file, sndlen,
-                            pstate->snd_foffset + pstate->snd_acked,
-                            tcpip_hdrsize(conn));
+      ret = sendfile_send(dev, pstate, sndlen, pstate->snd_acked);
       if (ret < 0)
         {
           nerr("ERROR: Failed to read from input file: %d\n", (int)ret);
@@ -340,9 +370,7 @@ static uint16_t sendfile_eventhandler(FAR struct net_driver_s *dev,
            * happen until the polling cycle completes).
            */
 
-          ret = devif_file_send(dev, pstate->snd_file, sndlen,
-                                pstate->snd_foffset + pstate->snd_sent,
-                                tcpip_hdrsize(conn));
+          ret = sendfile_send(dev, pstate, sndlen, pstate->snd_sent);
           if (ret < 0)
             {
               nerr("ERROR: Failed to read from input file: %d\n", (int)ret);
@@ -418,6 +446,9 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
 {
   FAR struct tcp_conn_s *conn;
   struct sendfile_s state;
+#ifdef CONFIG_IOB_ALLOC
+  FAR const uint8_t *xip;
+#endif
   off_t startpos;
   int ret = OK;
 
@@ -470,6 +501,14 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
       return startpos;
     }
 
+#ifdef CONFIG_IOB_ALLOC
+  /* Data that can never change (XIP ROMFS) is referenced from the packets
+   * instead of being read into them.
+   */
+
+  xip = file_xipdata(infile, offset ? *offset : startpos, count);
+#endif
+
   /* Initialize the state structure.  This is done with the network
    * locked because we don't want anything to happen until we are
    * ready.
@@ -486,6 +525,9 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
   state.snd_foffset = offset ? *offset : startpos; /* Input file offset */
   state.snd_flen    = count;                       /* Number of bytes to send */
   state.snd_file    = infile;                      /* File to read from */
+#ifdef CONFIG_IOB_ALLOC
+  state.snd_xip     = xip;                         /* Or data to reference */
+#endif
 
   /* Allocate resources to receive a callback */
 
@@ -545,6 +587,15 @@ errout_locked:
 #endif
   net_unlock();
 
+#ifdef CONFIG_IOB_ALLOC
+  /* The referenced data was not read, move the file position past it */
+
+  if (state.snd_xip != NULL && state.snd_sent > 0)
+    {
+      file_seek(infile, state.snd_foffset + state.snd_sent, SEEK_SET);
+    }
+#endif
+
   /* Return the current file position */
 
   if (offset)
@@ -98,6 +98,10 @@ FAR struct tcp_wrbuffer_s *tcp_wrbuffer_timedalloc(unsigned int timeout)
       return NULL;
     }
 
+#ifdef CONFIG_NET_TCP_ZEROCOPY
+  wrb->wb_zcopy = NULL;
+#endif
+
   /* Now get the first I/O buffer for the write buffer structure */
 
   wrb->wb_iob = net_iobtimedalloc(true, timeout);
@@ -186,6 +190,16 @@ void tcp_wrbuffer_release(FAR struct tcp_wrbuffer_s *wrb)
       iob_free_chain(wrb->wb_iob);
     }
 
+#ifdef CONFIG_NET_TCP_ZEROCOPY
+  /* The user data of a zero-copy send is no longer referenced */
+
+  if (wrb->wb_zcopy != NULL)
+    {
+      tcp_zcopy_put(wrb->wb_zcopy);
+      wrb->wb_zcopy = NULL;
+    }
+#endif
+
 #if defined(CONFIG_NET_TCP_FAST_RETRANSMIT) && !defined(CONFIG_NET_TCP_CC_NEWRENO)
   /* Reset the ack counter */
 
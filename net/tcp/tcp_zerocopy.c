@@ -0,0 +1,317 @@
+/****************************************************************************
+ * net/tcp/tcp_zerocopy.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/queue.h>
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/net.h>
+
+#include "utils/utils.h"
+#include "tcp/tcp.h"
+
+#ifdef CONFIG_NET_TCP_ZEROCOPY
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_zcopy_iobfree
+ *
+ * Description:
+ *   Free callback of the I/O buffers referencing user data.  The data
+ *   belongs to the application, there is nothing to release here, the
+ *   completion is reported when the write buffer is released.
+ *
+ ****************************************************************************/
+
+static void tcp_zcopy_iobfree(FAR void *data)
+{
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_zcopy_alloc
+ *
+ * Description:
+ *   Start a MSG_ZEROCOPY send call on the connection.  The returned
+ *   reference is dropped with tcp_zcopy_done() when the call returns.
+ *
+ * Returned Value:
+ *   The zero-copy send call or NULL if out of memory.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+FAR struct tcp_zcopy_s *tcp_zcopy_alloc(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_zcopy_s *zc;
+
+  /* The number of the call is only assigned when its first data is
+   * queued, so that a call that queues nothing never uses a number, even
+   * if other send calls on the connection run concurrently.
+   */
+
+  zc = kmm_malloc(sizeof(struct tcp_zcopy_s));
+  if (zc != NULL)
+    {
+      zc->zc_conn   = conn;
+      zc->zc_refs   = 1;
+      zc->zc_queued = false;
+    }
+
+  return zc;
+}
+
+/****************************************************************************
+ * Name: tcp_zcopy_put
+ *
+ * Description:
+ *   Drop a reference to a zero-copy send call.  The last reference queues
+ *   its completion on the error queue of the connection.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+void tcp_zcopy_put(FAR struct tcp_zcopy_s *zc)
+{
+  FAR struct tcp_conn_s *conn = zc->zc_conn;
+  FAR struct tcp_zcopy_s *tail;
+
+  DEBUGASSERT(zc->zc_refs > 0);
+  if (--zc->zc_refs > 0)
+    {
+      return;
+    }
+
+  ninfo("conn=%p zero-copy sends %" PRIu32 "-%" PRIu32 " completed\n",
+        conn, zc->zc_lo, zc->zc_hi);
+
+  /* Merge with the previous completion if the calls are contiguous, so a
+   * stream of sends is reported with a single error queue message.
+   */
+
+  tail = (FAR struct tcp_zcopy_s *)sq_tail(&conn->zc_errq);
+  if (tail != NULL && tail->zc_hi + 1 == zc->zc_lo)
+    {
+      tail->zc_hi = zc->zc_hi;
+      kmm_free(zc);
+    }
+  else
+    {
+      sq_addlast(&zc->zc_node, &conn->zc_errq);
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_zcopy_done
+ *
+ * Description:
+ *   End a MSG_ZEROCOPY send call and drop the reference of the caller.  If
+ *   no data was queued, the call never got a number and is forgotten
+ *   without reporting a completion, as for a failed send.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+void tcp_zcopy_done(FAR struct tcp_zcopy_s *zc)
+{
+  if (!zc->zc_queued)
+    {
+      DEBUGASSERT(zc->zc_refs == 1);
+      kmm_free(zc);
+    }
+  else
+    {
+      tcp_zcopy_put(zc);
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_zcopy_append
+ *
+ * Description:
+ *   Append user data to a write buffer without copying it.
+ *
+ * Returned Value:
+ *   The number of bytes appended (len) or -ENOMEM.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+int tcp_zcopy_append(FAR struct tcp_wrbuffer_s *wrb,
+                     FAR struct tcp_zcopy_s *zc,
+                     FAR const uint8_t *buf, size_t len)
+{
+  FAR struct iob_s *head = TCP_WBIOB(wrb);
+  FAR struct iob_s *iob;
+
+  /* A write buffer can only hold the data of one zero-copy send call */
+
+  DEBUGASSERT(wrb->wb_zcopy == NULL || wrb->wb_zcopy == zc);
+  DEBUGASSERT(len <= UINT16_MAX);
+
+  iob = iob_alloc_with_data((FAR void *)buf, len, tcp_zcopy_iobfree);
+  if (iob == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  iob->io_len    = len;
+  iob->io_pktlen = len;
+
+  if (head->io_pktlen == 0)
+    {
+      /* Replace the empty I/O buffer of a new write buffer */
+
+      iob_free_chain(head);
+      wrb->wb_iob = iob;
+    }
+  else
+    {
+      head->io_pktlen += len;
+      while (head->io_flink != NULL)
+        {
+          head = head->io_flink;
+        }
+
+      head->io_flink = iob;
+    }
+
+  if (wrb->wb_zcopy == NULL)
+    {
+      wrb->wb_zcopy = zc;
+      zc->zc_refs++;
+    }
+
+  if (!zc->zc_queued)
+    {
+      zc->zc_lo     = zc->zc_conn->zc_id;
+      zc->zc_hi     = zc->zc_conn->zc_id++;
+      zc->zc_queued = true;
+    }
+
+  return len;
+}
+
+/****************************************************************************
+ * Name: tcp_zcopy_recverr
+ *
+ * Description:
+ *   Read the oldest zero-copy completion with recvmsg(MSG_ERRQUEUE).
+ *
+ * Returned Value:
+ *   Zero on success, -EAGAIN if no completion is pending.
+ *
+ ****************************************************************************/
+
+ssize_t tcp_zcopy_recverr(FAR struct tcp_conn_s *conn,
+                          FAR struct msghdr *msg)
+{
+  FAR struct tcp_zcopy_s *zc;
+  struct sock_extended_err ee;
+  int level = SOL_IP;
+  int type = IP_RECVERR;
+
+  net_lock();
+
+  zc = (FAR struct tcp_zcopy_s *)sq_remfirst(&conn->zc_errq);
+  if (zc == NULL)
+    {
+      net_unlock();
+      return -EAGAIN;
+    }
+
+  net_unlock();
+
+  memset(&ee, 0, sizeof(ee));
+  ee.ee_origin = SO_EE_ORIGIN_ZEROCOPY;
+  ee.ee_info   = zc->zc_lo;
+  ee.ee_data   = zc->zc_hi;
+  kmm_free(zc);
+
+#ifdef CONFIG_NET_IPv6
+  if (conn->domain == PF_INET6)
+    {
+      level = SOL_IPV6;
+      type  = IPV6_RECVERR;
+    }
+#endif
+
+  msg->msg_flags |= MSG_ERRQUEUE;
+  if (cmsg_append(msg, level, type, &ee, sizeof(ee)) == NULL)
+    {
+      msg->msg_flags |= MSG_CTRUNC;
+    }
+
+  return 0;
+}
+
+/****************************************************************************
+ * Name: tcp_zcopy_free
+ *
+ * Description:
+ *   Discard all pending completions of a connection being freed.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+void tcp_zcopy_free(FAR struct tcp_conn_s *conn)
+{
+  FAR sq_entry_t *entry;
+
+  while ((entry = sq_remfirst(&conn->zc_errq)) != NULL)
+    {
+      kmm_free(entry);
+    }
+}
+
+#endif /* CONFIG_NET_TCP_ZEROCOPY */
@@ -32,6 +32,7 @@
 #include <sys/types.h>
 #include <sys/socket.h>
 
+#include <nuttx/hashtable.h>
 #include <nuttx/queue.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/net/ip.h>
@@ -50,6 +51,12 @@
  ****************************************************************************/
 
 #ifdef CONFIG_NET_UDP_WRITE_BUFFERS
+/* The payload of a write buffer is summed while it is copied in */
+
+#  if defined(CONFIG_NET_UDP_CHECKSUMS) && !defined(CONFIG_NET_ARCH_CHKSUM)
+#    define NET_UDP_HAVE_SNDSUM 1
+#  endif
+
 /* UDP write buffer dump macros */
 
 #  ifdef CONFIG_DEBUG_FEATURES
@@ -70,6 +77,7 @@
 /* Definitions for the UDP connection struct flag field */
 
 #define _UDP_FLAG_CONNECTMODE (1 << 0) /* Bit 0:  UDP connection-mode */
+#define _UDP_FLAG_SNDSUM      (1 << 1) /* Bit 1:  sndsum is valid */
 
 #define _UDP_ISCONNECTMODE(f) (((f) & _UDP_FLAG_CONNECTMODE) != 0)
 
@@ -111,6 +119,7 @@ struct udp_conn_s
   /* UDP-specific content follows */
 
   union ip_binding_u u;   /* IP address binding */
+  hash_node_t hnode;      /* Link in the hashtable of local ports */
   uint16_t lport;         /* Bound local port number (network byte order) */
   uint16_t rport;         /* Remote port number (network byte order) */
   uint8_t  flags;         /* See _UDP_FLAG_* definitions */
@@ -147,6 +156,10 @@ struct udp_conn_s
   /* Callback instance for UDP sendto() */
 
   FAR struct devif_callback_s *sndcb;
+
+#ifdef NET_UDP_HAVE_SNDSUM
+  uint16_t sndsum;                /* Payload sum of the packet being sent */
+#endif
 #endif
 
 #if defined(CONFIG_NET_IGMP) || defined(CONFIG_NET_MLD)
@@ -174,6 +187,9 @@ struct udp_wrbuffer_s
   sq_entry_t wb_node;              /* Supports a singly linked list */
   struct sockaddr_storage wb_dest; /* Destination address */
   FAR struct iob_s *wb_iob;        /* Head of the I/O buffer chain */
+#ifdef NET_UDP_HAVE_SNDSUM
+  uint16_t wb_sum;                 /* Raw sum of the payload */
+#endif
 };
 #endif
 
@@ -263,6 +279,48 @@ FAR struct udp_conn_s *udp_active(FAR struct net_driver_s *dev,
 
 FAR struct udp_conn_s *udp_nextconn(FAR struct udp_conn_s *conn);
 
+/****************************************************************************
+ * Name: udp_setport
+ *
+ * Description:
+ *   Set the local port of a UDP connection and move the connection to the
+ *   matching bucket of the port hashtable.  A port of zero unbinds it.
+ *
+ * Input Parameters:
+ *   conn   - The UDP connection
+ *   portno - The local port (network byte order)
+ *
+ ****************************************************************************/
+
+void udp_setport(FAR struct udp_conn_s *conn, uint16_t portno);
+
+/****************************************************************************
+ * Name: udp_reuseport_select
+ *
+ * Description:
+ *   Select one member of a group of SO_REUSEPORT sockets for a unicast
+ *   datagram.  The choice is a hash of the source address and port, so
+ *   that all datagrams of one flow go to the same socket.
+ *
+ * Input Parameters:
+ *   dev  - The device driver structure containing the received packet
+ *   conn - The first connection returned by udp_active()
+ *   udp  - The UDP header of the packet
+ *
+ * Returned Value:
+ *   The selected connection; 'conn' if it does not use SO_REUSEPORT.
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_SOCKOPTS
+FAR struct udp_conn_s *udp_reuseport_select(FAR struct net_driver_s *dev,
+                                            FAR struct udp_conn_s *conn,
+                                            FAR struct udp_hdr_s *udp);
+#endif
+
 /****************************************************************************
  * Name: udp_select_port
  *
@@ -753,6 +811,27 @@ void udp_callback_cleanup(FAR void *arg);
 ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
                            int flags);
 
+/****************************************************************************
+ * Name: psock_udp_recvmmsg
+ *
+ * Description:
+ *   Receive the UDP datagrams already buffered on a SOCK_DGRAM socket into
+ *   several messages, without waiting.
+ *
+ * Input Parameters:
+ *   psock    Pointer to the socket structure for the SOCK_DRAM socket
+ *   msgvec   Buffers to receive the datagrams
+ *   vlen     The number of messages in msgvec
+ *   flags    Receive flags
+ *
+ * Returned Value:
+ *   The number of datagrams received, possibly zero.
+ *
+ ****************************************************************************/
+
+int psock_udp_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                       unsigned int vlen, int flags);
+
 /****************************************************************************
  * Name: psock_udp_sendto
  *
@@ -57,6 +57,7 @@
 #include <arch/irq.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/hashtable.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/mutex.h>
 #include <nuttx/net/netconfig.h>
@@ -97,10 +98,42 @@ static mutex_t g_free_lock = NXMUTEX_INITIALIZER;
 
 static dq_queue_t g_active_udp_connections;
 
+/* The bound connections, hashed by local port */
+
+static DECLARE_HASHTABLE(g_udp_port_hash, CONFIG_NET_UDP_HASH_BITS);
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: udp_hash_next
+ *
+ * Description:
+ *   Return the connection after 'conn' in the hashtable bucket of 'portno',
+ *   or the first connection of the bucket if 'conn' is NULL.  The bucket
+ *   may also hold connections bound to other ports.
+ *
+ ****************************************************************************/
+
+static FAR struct udp_conn_s *udp_hash_next(FAR struct udp_conn_s *conn,
+                                            uint16_t portno)
+{
+  FAR hash_node_t *p;
+
+  if (conn == NULL)
+    {
+      p = g_udp_port_hash[HASH(portno,
+                               hashtable_bits(g_udp_port_hash))].head;
+    }
+  else
+    {
+      p = conn->hnode.flink;
+    }
+
+  return p != NULL ? container_of(p, struct udp_conn_s, hnode) : NULL;
+}
+
 /****************************************************************************
  * Name: udp_find_conn()
  *
@@ -126,18 +159,22 @@ static FAR struct udp_conn_s *udp_find_conn(uint8_t domain,
   FAR struct udp_conn_s *conn = NULL;
 #ifdef CONFIG_NET_SOCKOPTS
   bool skip_reusable = _SO_GETOPT(opt, SO_REUSEADDR);
+  bool skip_reuseport = _SO_GETOPT(opt, SO_REUSEPORT);
 #endif
 
-  /* Now search each connection structure. */
+  /* Now search each connection structure bound to the same port. */
 
-  while ((conn = udp_nextconn(conn)) != NULL)
+  while ((conn = udp_hash_next(conn, portno)) != NULL)
     {
-      /* With SO_REUSEADDR set for both sockets, we do not need to check its
-       * address and port.
+      /* With SO_REUSEADDR or SO_REUSEPORT set for both sockets, we do not
+       * need to check its address and port.
        */
 
 #ifdef CONFIG_NET_SOCKOPTS
-      if (skip_reusable && _SO_GETOPT(conn->sconn.s_options, SO_REUSEADDR))
+      if ((skip_reusable &&
+           _SO_GETOPT(conn->sconn.s_options, SO_REUSEADDR)) ||
+          (skip_reuseport &&
+           _SO_GETOPT(conn->sconn.s_options, SO_REUSEPORT)))
         {
           continue;
         }
@@ -203,7 +240,7 @@ udp_ipv4_active(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn,
 #endif
   FAR struct ipv4_hdr_s *ip = IPv4BUF;
 
-  conn = udp_nextconn(conn);
+  conn = udp_hash_next(conn, udp->destport);
 
   while (conn)
     {
@@ -315,9 +352,9 @@ udp_ipv4_active(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn,
             }
         }
 
-      /* Look at the next active connection */
+      /* Look at the next connection bound to the same port */
 
-      conn = (FAR struct udp_conn_s *)conn->sconn.node.flink;
+      conn = udp_hash_next(conn, udp->destport);
     }
 
   return conn;
@@ -343,7 +380,7 @@ udp_ipv6_active(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn,
 {
   FAR struct ipv6_hdr_s *ip = IPv6BUF;
 
-  conn = udp_nextconn(conn);
+  conn = udp_hash_next(conn, udp->destport);
 
   while (conn != NULL)
     {
@@ -455,9 +492,9 @@ udp_ipv6_active(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn,
             }
         }
 
-      /* Look at the next active connection */
+      /* Look at the next connection bound to the same port */
 
-      conn = (FAR struct udp_conn_s *)conn->sconn.node.flink;
+      conn = udp_hash_next(conn, udp->destport);
     }
 
   return conn;
@@ -549,6 +586,7 @@ errout:
 
 void udp_initialize(void)
 {
+  hashtable_init(g_udp_port_hash);
 }
 
 /****************************************************************************
@@ -593,6 +631,9 @@ FAR struct udp_conn_s *udp_alloc(uint8_t domain)
       /* Initialize the write buffer lists */
 
       sq_init(&conn->write_q);
+#endif
+#ifdef CONFIG_NET_CONN_LOCK
+      nxmutex_init(&conn->sconn.s_lock);
 #endif
       /* Enqueue the connection into the active list */
 
@@ -623,7 +664,7 @@ void udp_free(FAR struct udp_conn_s *conn)
   DEBUGASSERT(conn->crefs == 0);
 
   nxmutex_lock(&g_free_lock);
-  conn->lport = 0;
+  udp_setport(conn, 0);
 
   /* Remove the connection from the active list */
 
@@ -631,7 +672,10 @@ void udp_free(FAR struct udp_conn_s *conn)
 
   /* Release any read-ahead buffers attached to the connection, NULL is ok */
 
+  conn_lock(&conn->sconn);
   iob_free_chain(conn->readahead);
+  conn->readahead = NULL;
+  conn_unlock(&conn->sconn);
 
 #ifdef CONFIG_NET_UDP_WRITE_BUFFERS
   /* Release any write buffers attached to the connection */
@@ -648,6 +692,10 @@ void udp_free(FAR struct udp_conn_s *conn)
   udp_sendbuffer_notify(conn);
 #endif /* CONFIG_NET_SEND_BUFSIZE */
 
+#endif
+
+#ifdef CONFIG_NET_CONN_LOCK
+  nxmutex_destroy(&conn->sconn.s_lock);
 #endif
 
   /* Free the connection. */
@@ -715,6 +763,109 @@ FAR struct udp_conn_s *udp_nextconn(FAR struct udp_conn_s *conn)
     }
 }
 
+/****************************************************************************
+ * Name: udp_setport
+ *
+ * Description:
+ *   Set the local port of a UDP connection and move the connection to the
+ *   matching bucket of the port hashtable.  A port of zero unbinds it.
+ *
+ ****************************************************************************/
+
+void udp_setport(FAR struct udp_conn_s *conn, uint16_t portno)
+{
+  net_lock();
+
+  if (conn->lport != 0)
+    {
+      hashtable_delete(g_udp_port_hash, &conn->hnode, conn->lport);
+    }
+
+  conn->lport = portno;
+
+  if (portno != 0)
+    {
+      hashtable_add(g_udp_port_hash, &conn->hnode, portno);
+    }
+
+  net_unlock();
+}
+
+/****************************************************************************
+ * Name: udp_reuseport_select
+ *
+ * Description:
+ *   Select one member of a group of SO_REUSEPORT sockets for a unicast
+ *   datagram.  The choice is a hash of the source address and port, so
+ *   that all datagrams of one flow go to the same socket.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_SOCKOPTS
+FAR struct udp_conn_s *udp_reuseport_select(FAR struct net_driver_s *dev,
+                                            FAR struct udp_conn_s *conn,
+                                            FAR struct udp_hdr_s *udp)
+{
+  FAR struct udp_conn_s *tmp;
+  uint32_t key = 0;
+  int count = 0;
+  int index;
+
+  if (!_SO_GETOPT(conn->sconn.s_options, SO_REUSEPORT))
+    {
+      return conn;
+    }
+
+  /* Count the SO_REUSEPORT sockets that accept this datagram */
+
+  for (tmp = conn; tmp != NULL; tmp = udp_active(dev, tmp, udp))
+    {
+      if (_SO_GETOPT(tmp->sconn.s_options, SO_REUSEPORT))
+        {
+          count++;
+        }
+    }
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (IFF_IS_IPv6(dev->d_flags))
+#endif
+    {
+      FAR struct ipv6_hdr_s *ip = IPv6BUF;
+      key = net_ip4addr_conv32(&ip->srcipaddr[6]);
+    }
+#endif /* CONFIG_NET_IPv6 */
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      FAR struct ipv4_hdr_s *ip = IPv4BUF;
+      key = net_ip4addr_conv32(ip->srcipaddr);
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+  /* The upper bits of the hash are the best mixed ones */
+
+  key  ^= (uint32_t)udp->srcport << 16;
+  index = HASH(key, 16) % count;
+
+  for (tmp = conn; tmp != NULL; tmp = udp_active(dev, tmp, udp))
+    {
+      if (_SO_GETOPT(tmp->sconn.s_options, SO_REUSEPORT) && index-- == 0)
+        {
+          return tmp;
+        }
+    }
+
+  return conn;
+}
+#endif /* CONFIG_NET_SOCKOPTS */
+
 /****************************************************************************
  * Name: udp_bind
  *
@@ -852,7 +1003,7 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
         }
       else
         {
-          conn->lport = portno;
+          udp_setport(conn, portno);
           ret         = OK;
         }
     }
@@ -877,7 +1028,7 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
         {
           /* No.. then bind the socket to the port */
 
-          conn->lport = portno;
+          udp_setport(conn, portno);
           ret         = OK;
         }
       else
@@ -921,6 +1072,8 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
 
 int udp_connect(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
 {
+  uint16_t portno;
+
   /* Has this address already been bound to a local port (lport)? */
 
   if (!conn->lport)
@@ -929,12 +1082,14 @@ int udp_connect(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
        * connection structure.
        */
 
-      conn->lport = HTONS(udp_select_port(conn->domain, &conn->u));
-      if (!conn->lport)
+      portno = HTONS(udp_select_port(conn->domain, &conn->u));
+      if (!portno)
         {
           nerr("ERROR: Failed to get a local port!\n");
           return -EADDRINUSE;
         }
+
+      udp_setport(conn, portno);
     }
 
   /* Is there a remote port (rport)? */
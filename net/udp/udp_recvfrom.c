@@ -170,6 +170,18 @@ static inline size_t udp_recvfrom_newdata(FAR struct net_driver_s *dev,
   return recvlen;
 }
 
+/****************************************************************************
+ * Name: udp_readahead
+ *
+ * Description:
+ *   Copy the oldest buffered datagram to the user buffer.
+ *   pstate->ir_recvlen is set to -1 if there is none.
+ *
+ * Assumptions:
+ *   The read-ahead buffers of the connection are locked.
+ *
+ ****************************************************************************/
+
 static inline void udp_readahead(struct udp_recvfrom_s *pstate)
 {
   FAR struct udp_conn_s *conn = pstate->ir_conn;
@@ -690,6 +702,29 @@ ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
       return -ENOTSUP;
     }
 
+#ifdef CONFIG_NET_CONN_LOCK
+  /* A datagram that is already buffered is copied out under the lock of
+   * the connection only.
+   */
+
+  udp_recvfrom_initialize(conn, msg, &state, flags);
+  conn_lock(&conn->sconn);
+  udp_readahead(&state);
+  conn_unlock(&conn->sconn);
+  if (state.ir_recvlen >= 0)
+    {
+#ifdef CONFIG_NETDEV_RSS
+      net_lock();
+      udp_notify_recvcpu(conn);
+      net_unlock();
+#endif
+      udp_recvfrom_uninitialize(&state);
+      return state.ir_recvlen;
+    }
+
+  udp_recvfrom_uninitialize(&state);
+#endif
+
   /* Initialize the state structure.  This is done with the network locked
    * because we don't want anything to happen until we are ready.
    */
@@ -699,7 +734,9 @@ ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
 
   /* Copy the read-ahead data from the packet */
 
+  conn_lock(&conn->sconn);
   udp_readahead(&state);
+  conn_unlock(&conn->sconn);
 
   /* The default return value is the number of bytes that we just copied
    * into the user buffer.  We will return this if the socket has become
@@ -794,4 +831,87 @@ ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
   return ret;
 }
 
+/****************************************************************************
+ * Name: psock_udp_recvmmsg
+ *
+ * Description:
+ *   Receive the UDP datagrams already buffered on a SOCK_DGRAM socket into
+ *   several messages, without waiting.  The read-ahead buffers are locked
+ *   once for the whole batch.
+ *
+ * Input Parameters:
+ *   psock    Pointer to the socket structure for the SOCK_DRAM socket
+ *   msgvec   Buffers to receive the datagrams
+ *   vlen     The number of messages in msgvec
+ *   flags    Receive flags
+ *
+ * Returned Value:
+ *   The number of datagrams received, possibly zero.
+ *
+ ****************************************************************************/
+
+int psock_udp_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                       unsigned int vlen, int flags)
+{
+  FAR struct udp_conn_s *conn = psock->s_conn;
+  struct udp_recvfrom_s state;
+  unsigned int nrecv;
+
+  /* MSG_PEEK would return the same datagram into every message */
+
+  if ((flags & MSG_PEEK) != 0)
+    {
+      return 0;
+    }
+
+  memset(&state, 0, sizeof(struct udp_recvfrom_s));
+  state.ir_conn  = conn;
+  state.ir_flags = flags;
+
+#ifdef CONFIG_NET_CONN_LOCK
+  conn_lock(&conn->sconn);
+#else
+  net_lock();
+#endif
+
+  for (nrecv = 0; nrecv < vlen; nrecv++)
+    {
+      FAR struct msghdr *msg = &msgvec[nrecv].msg_hdr;
+      FAR void *msg_control = msg->msg_control;
+      unsigned long msg_controllen = msg->msg_controllen;
+
+      /* Invalid messages are left to recvmsg() to report */
+
+      if (msg->msg_iovlen != 1 || msg->msg_iov == NULL ||
+          msg->msg_iov->iov_base == NULL ||
+          (msg->msg_name != NULL && msg->msg_namelen <= 0))
+        {
+          break;
+        }
+
+      state.ir_msg = msg;
+      udp_readahead(&state);
+      if (state.ir_recvlen < 0)
+        {
+          break;
+        }
+
+      /* Recover the pointer and calculate the cmsg's true data length, as
+       * psock_recvmsg() does.
+       */
+
+      msg->msg_control    = msg_control;
+      msg->msg_controllen = msg_controllen - msg->msg_controllen;
+      msgvec[nrecv].msg_len = state.ir_recvlen;
+    }
+
+#ifdef CONFIG_NET_CONN_LOCK
+  conn_unlock(&conn->sconn);
+#else
+  net_unlock();
+#endif
+
+  return nrecv;
+}
+
 #endif /* CONFIG_NET && CONFIG_NET_UDP */
@@ -152,6 +152,11 @@ void udp_send(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn)
 #ifdef CONFIG_NET_IPv4
   in_addr_t raddr;
 #endif
+#ifdef NET_UDP_HAVE_SNDSUM
+  bool sndsum = (conn->flags & _UDP_FLAG_SNDSUM) != 0;
+
+  conn->flags &= ~_UDP_FLAG_SNDSUM;
+#endif
 
   ninfo("UDP payload: %d (%d) bytes\n", dev->d_sndlen, dev->d_len);
 
@@ -255,7 +260,16 @@ void udp_send(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn)
       if (IFF_IS_IPv4(dev->d_flags))
 #endif
         {
-          udp->udpchksum = ~udp_ipv4_chksum(dev);
+#ifdef NET_UDP_HAVE_SNDSUM
+          if (sndsum)
+            {
+              udp->udpchksum = ~udp_ipv4_hdrchksum(dev, conn->sndsum);
+            }
+          else
+#endif
+            {
+              udp->udpchksum = ~udp_ipv4_chksum(dev);
+            }
         }
 #endif /* CONFIG_NET_IPv4 */
 
@@ -264,7 +278,16 @@ void udp_send(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn)
       else
 #endif
         {
-          udp->udpchksum = ~udp_ipv6_chksum(dev);
+#ifdef NET_UDP_HAVE_SNDSUM
+          if (sndsum)
+            {
+              udp->udpchksum = ~udp_ipv6_hdrchksum(dev, conn->sndsum);
+            }
+          else
+#endif
+            {
+              udp->udpchksum = ~udp_ipv6_chksum(dev);
+            }
         }
 #endif /* CONFIG_NET_IPv6 */
 
@@ -258,12 +258,14 @@ static int sendto_next_transfer(FAR struct udp_conn_s *conn)
        * connection structure.
        */
 
-      conn->lport = HTONS(udp_select_port(conn->domain, &conn->u));
-      if (!conn->lport)
+      uint16_t portno = HTONS(udp_select_port(conn->domain, &conn->u));
+      if (!portno)
         {
           nerr("ERROR: Failed to get a local port!\n");
           return -EADDRINUSE;
         }
+
+      udp_setport(conn, portno);
     }
 
   /* Get the device that will handle the remote packet transfers.  This
@@ -451,6 +453,15 @@ static uint16_t sendto_eventhandler(FAR struct net_driver_s *dev,
       dev->d_sndlen = wrb->wb_iob->io_pktlen - udpiplen;
       ninfo("wrb=%p sndlen=%d\n", wrb, dev->d_sndlen);
 
+#ifdef NET_UDP_HAVE_SNDSUM
+      /* The payload was summed when it was copied in, udp_send() only
+       * needs to add the headers.
+       */
+
+      conn->sndsum = wrb->wb_sum;
+      conn->flags |= _UDP_FLAG_SNDSUM;
+#endif
+
       /* Do not need to release wb_iob, the life cycle of wb_iob is
        * handed over to the network device
        */
@@ -819,8 +830,14 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
 
       if (nonblock)
         {
+#ifdef NET_UDP_HAVE_SNDSUM
+          wrb->wb_sum = 0;
+          ret = chksum_iob_trycopyin(wrb->wb_iob, (FAR uint8_t *)buf,
+                                     len, udpiplen, false, &wrb->wb_sum);
+#else
           ret = iob_trycopyin(wrb->wb_iob, (FAR uint8_t *)buf,
                               len, udpiplen, false);
+#endif
         }
       else
         {
@@ -833,8 +850,14 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
            */
 
           blresult = net_breaklock(&count);
+#ifdef NET_UDP_HAVE_SNDSUM
+          wrb->wb_sum = 0;
+          ret = chksum_iob_copyin(wrb->wb_iob, (FAR uint8_t *)buf,
+                                  len, udpiplen, false, &wrb->wb_sum);
+#else
           ret = iob_copyin(wrb->wb_iob, (FAR uint8_t *)buf,
                            len, udpiplen, false);
+#endif
           if (blresult >= 0)
             {
               net_restorelock(count);
@@ -27,87 +27,236 @@
 #include <nuttx/config.h>
 #ifdef CONFIG_NET
 
+#include <stdbool.h>
+#include <string.h>
+
 #include "utils/utils.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The generic checksum is needed unless the architecture provides all of
+ * its users.
+ */
+
+#if !defined(CONFIG_NET_ARCH_CHKSUM) || \
+    !defined(CONFIG_NET_ARCH_CHKSUM_COPY) || defined(CONFIG_MM_IOB)
+#  define NET_GENERIC_CHKSUM 1
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* State of chksum_iob_copyin() across the I/O buffers */
+
+#ifdef CONFIG_MM_IOB
+struct chksum_copyin_s
+{
+  uint16_t sum;  /* Partial checksum */
+  bool     odd;  /* The data copied so far ends on an odd byte */
+};
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+#ifdef NET_GENERIC_CHKSUM
+
 /****************************************************************************
- * Name: checksum
+ * Name: chksum_add
  *
  * Description:
- *   Calculate the raw change sum over the memory region described by
- *   data and len.
+ *   One's complement addition of two 16-bit partial sums.
  *
- * Input Parameters:
- *   sum  - Partial calculations carried over from a previous call to
- *          chksum().  This should be zero on the first time that check
- *          sum is called.
- *   data - Beginning of the data to include in the checksum.
- *   len  - Length of the data to include in the checksum.
- *   odd  - the flag of the Calculated data sum
+ ****************************************************************************/
+
+static inline uint16_t chksum_add(uint16_t sum, uint16_t t)
+{
+  sum += t;
+  if (sum < t)
+    {
+      sum++; /* carry */
+    }
+
+  return sum;
+}
+
+/****************************************************************************
+ * Name: chksum_fold
  *
- * Returned Value:
- *   The updated checksum value.
+ * Description:
+ *   Fold a 64-bit accumulator of native-endian words into a 16-bit partial
+ *   sum in host byte order.
+ *
+ *   The one's complement sum is independent of the byte order (RFC1071),
+ *   so the words are loaded natively and the folded result is swapped
+ *   back to the network word order once.
  *
  ****************************************************************************/
 
-#ifndef CONFIG_NET_ARCH_CHKSUM
-uint16_t checksum(uint16_t sum, FAR const uint8_t *data,
-                    uint16_t len, bool *odd)
+static inline uint16_t chksum_fold(uint64_t acc)
 {
-  FAR const uint8_t *dataptr;
-  FAR const uint8_t *last_byte;
-  uint16_t t;
+  acc = (acc & 0xffffffff) + (acc >> 32);
+  acc = (acc & 0xffffffff) + (acc >> 32);
+  acc = (acc & 0xffff) + (acc >> 16);
+  acc = (acc & 0xffff) + (acc >> 16);
+
+  return NTOHS((uint16_t)acc);
+}
+
+/****************************************************************************
+ * Name: chksum_words
+ *
+ * Description:
+ *   Sum the memory region described by data and len, which starts at an
+ *   even position of the checksummed stream.  If dest is not NULL, the
+ *   data is copied to dest in the same pass.
+ *
+ *   The data is accumulated 32 bits at a time into a 64-bit accumulator,
+ *   so no carry has to be propagated inside the loop.  A packet of at
+ *   most 64KiB cannot overflow the accumulator.
+ *
+ ****************************************************************************/
 
-  dataptr = data;
-  last_byte = data + len - 1;
+static uint16_t chksum_words(FAR uint8_t *dest, FAR const uint8_t *data,
+                             uint16_t len)
+{
+  uint64_t acc = 0;
+  uint32_t w[4];
+  uint16_t h;
 
-  if (*odd == true)
+  while (len >= sizeof(w))
     {
-      t = dataptr[0];
-      sum += t;
-      if (sum < t)
+      memcpy(w, data, sizeof(w));
+      if (dest != NULL)
         {
-          sum++; /* carry */
+          memcpy(dest, w, sizeof(w));
+          dest += sizeof(w);
         }
 
-      dataptr += 1;
+      acc  += (uint64_t)w[0] + w[1] + (uint64_t)w[2] + w[3];
+      data += sizeof(w);
+      len  -= sizeof(w);
     }
 
-  while (dataptr < last_byte)
+  while (len >= sizeof(w[0]))
     {
-      /* At least two more bytes */
+      memcpy(w, data, sizeof(w[0]));
+      if (dest != NULL)
+        {
+          memcpy(dest, w, sizeof(w[0]));
+          dest += sizeof(w[0]);
+        }
+
+      acc  += w[0];
+      data += sizeof(w[0]);
+      len  -= sizeof(w[0]);
+    }
 
-      t = ((uint16_t)dataptr[0] << 8) + dataptr[1];
-      sum += t;
-      if (sum < t)
+  if (len > 0)
+    {
+      /* One to three bytes are left, a trailing odd byte is the high
+       * byte of a zero padded word in network order.
+       */
+
+      h = 0;
+      memcpy(&h, data, len > 1 ? 2 : 1);
+      if (dest != NULL)
         {
-          sum++; /* carry */
+          memcpy(dest, data, len > 1 ? 2 : 1);
         }
 
-      dataptr += 2;
+      acc += h;
+      if (len == 3)
+        {
+          h = 0;
+          memcpy(&h, data + 2, 1);
+          if (dest != NULL)
+            {
+              dest[2] = data[2];
+            }
+
+          acc += h;
+        }
     }
 
-  *odd = false;
+  return chksum_fold(acc);
+}
+
+/****************************************************************************
+ * Name: checksum
+ *
+ * Description:
+ *   Calculate the raw change sum over the memory region described by
+ *   data and len, optionally copying the data to dest in the same pass.
+ *
+ * Input Parameters:
+ *   sum  - Partial calculations carried over from a previous call to
+ *          chksum().  This should be zero on the first time that check
+ *          sum is called.
+ *   dest - Copy destination, or NULL if the data is only summed.
+ *   data - Beginning of the data to include in the checksum.
+ *   len  - Length of the data to include in the checksum.
+ *   odd  - the flag of the Calculated data sum
+ *
+ * Returned Value:
+ *   The updated checksum value.
+ *
+ ****************************************************************************/
+
+static uint16_t checksum(uint16_t sum, FAR uint8_t *dest,
+                         FAR const uint8_t *data, uint16_t len,
+                         FAR bool *odd)
+{
+  if (len == 0)
+    {
+      return sum;
+    }
 
-  if (dataptr == last_byte)
+  if (*odd)
     {
-      t = (dataptr[0] << 8) + 0;
-      sum += t;
-      if (sum < t)
+      /* The previous region ended in the middle of a word, this byte is
+       * its low byte.
+       */
+
+      if (dest != NULL)
         {
-          sum++; /* carry */
+          *dest++ = *data;
         }
 
-      *odd = true;
+      sum = chksum_add(sum, *data++);
+      len--;
     }
 
+  sum  = chksum_add(sum, chksum_words(dest, data, len));
+  *odd = (len & 1) != 0;
+
   /* Return sum in host byte order. */
 
   return sum;
 }
+#endif /* NET_GENERIC_CHKSUM */
+
+/****************************************************************************
+ * Name: chksum_copyin
+ *
+ * Description:
+ *   iob_copyin_func() callback of chksum_iob_copyin().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_IOB
+static void chksum_copyin(FAR void *arg, FAR uint8_t *dest,
+                          FAR const uint8_t *src, unsigned int len)
+{
+  FAR struct chksum_copyin_s *state = arg;
+
+  state->sum = chksum_copy(state->sum, dest, src, len, &state->odd);
+}
+#endif
 
 /****************************************************************************
  * Public Functions
@@ -132,15 +281,43 @@ uint16_t checksum(uint16_t sum, FAR const uint8_t *data,
  *
  ****************************************************************************/
 
+#ifndef CONFIG_NET_ARCH_CHKSUM
 uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len)
 {
   bool odd = false;
 
-  return checksum(sum, data, len, &odd);
+  return checksum(sum, NULL, data, len, &odd);
 }
-
 #endif /* CONFIG_NET_ARCH_CHKSUM */
 
+/****************************************************************************
+ * Name: chksum_copy
+ *
+ * Description:
+ *   Copy the memory region described by src and len to dest and calculate
+ *   its raw change sum in the same pass.
+ *
+ * Input Parameters:
+ *   sum  - Partial calculations carried over from a previous call.
+ *   dest - Destination of the copy.
+ *   src  - Beginning of the data to copy and include in the checksum.
+ *   len  - Length of the data to copy.
+ *   odd  - In: the previous region ended on an odd byte.  Out: this
+ *          region ends on an odd byte.  Should be false on the first call.
+ *
+ * Returned Value:
+ *   The updated checksum value.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_NET_ARCH_CHKSUM_COPY
+uint16_t chksum_copy(uint16_t sum, FAR uint8_t *dest,
+                     FAR const uint8_t *src, uint16_t len, FAR bool *odd)
+{
+  return checksum(sum, dest, src, len, odd);
+}
+#endif /* CONFIG_NET_ARCH_CHKSUM_COPY */
+
 /****************************************************************************
  * Name: chksum_iob
  *
@@ -178,8 +355,8 @@ uint16_t chksum_iob(uint16_t sum, FAR struct iob_s *iob, uint16_t offset)
 
   while (iob != NULL)
     {
-      sum = checksum(sum, iob->io_data + iob->io_offset + offset,
-                      iob->io_len - offset, &odd);
+      sum = checksum(sum, NULL, iob->io_data + iob->io_offset + offset,
+                     iob->io_len - offset, &odd);
       iob = iob->io_flink;
       offset = 0;
     }
@@ -188,6 +365,73 @@ uint16_t chksum_iob(uint16_t sum, FAR struct iob_s *iob, uint16_t offset)
 }
 #endif /* CONFIG_MM_IOB */
 
+/****************************************************************************
+ * Name: chksum_iob_copyin
+ *
+ * Description:
+ *   Copy data from a user buffer into an iob chain, as iob_copyin() does,
+ *   and calculate the raw change sum of the copied data in the same pass.
+ *
+ * Input Parameters:
+ *   iob       - The iob chain to copy into, extended as necessary.
+ *   src       - The data to copy.
+ *   len       - Length of the data to copy.
+ *   offset    - Offset in the iob chain of the copy.
+ *   throttled - Whether the iob allocations are throttled.
+ *   sum       - In: partial calculations carried over from a previous
+ *               call, should be zero the first time.  Out: the updated
+ *               checksum value.
+ *
+ * Returned Value:
+ *   The number of uncopied bytes left if >= 0 OR a negative error code.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_IOB
+int chksum_iob_copyin(FAR struct iob_s *iob, FAR const uint8_t *src,
+                      unsigned int len, int offset, bool throttled,
+                      FAR uint16_t *sum)
+{
+  struct chksum_copyin_s state;
+  int ret;
+
+  state.sum = *sum;
+  state.odd = false;
+
+  ret = iob_copyin_func(iob, src, len, offset, throttled,
+                        chksum_copyin, &state);
+
+  *sum = state.sum;
+  return ret;
+}
+
+/****************************************************************************
+ * Name: chksum_iob_trycopyin
+ *
+ * Description:
+ *   Like chksum_iob_copyin() BUT without waiting if buffers are not
+ *   available.
+ *
+ ****************************************************************************/
+
+int chksum_iob_trycopyin(FAR struct iob_s *iob, FAR const uint8_t *src,
+                         unsigned int len, int offset, bool throttled,
+                         FAR uint16_t *sum)
+{
+  struct chksum_copyin_s state;
+  int ret;
+
+  state.sum = *sum;
+  state.odd = false;
+
+  ret = iob_trycopyin_func(iob, src, len, offset, throttled,
+                           chksum_copyin, &state);
+
+  *sum = state.sum;
+  return ret;
+}
+#endif /* CONFIG_MM_IOB */
+
 /****************************************************************************
  * Name: net_chksum
  *
@@ -179,6 +179,46 @@ void net_unlock(void)
   nxrmutex_unlock(&g_netlock);
 }
 
+/****************************************************************************
+ * Name: conn_lock
+ *
+ * Description:
+ *   Take the lock of one connection.
+ *
+ * Input Parameters:
+ *   sconn - The common part of the connection
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_CONN_LOCK
+void conn_lock(FAR struct socket_conn_s *sconn)
+{
+  nxmutex_lock(&sconn->s_lock);
+}
+
+/****************************************************************************
+ * Name: conn_unlock
+ *
+ * Description:
+ *   Release the lock of one connection.
+ *
+ * Input Parameters:
+ *   sconn - The common part of the connection
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void conn_unlock(FAR struct socket_conn_s *sconn)
+{
+  nxmutex_unlock(&sconn->s_lock);
+}
+#endif /* CONFIG_NET_CONN_LOCK */
+
 /****************************************************************************
  * Name: net_breaklock
  *
@@ -26,6 +26,7 @@
 
 #include <nuttx/config.h>
 #include <nuttx/net/netdev.h>
+#include <nuttx/net/udp.h>
 
 #include "utils/utils.h"
 
@@ -65,4 +66,68 @@ uint16_t udp_ipv6_chksum(FAR struct net_driver_s *dev)
 }
 #endif
 
+/****************************************************************************
+ * Name: udp_hdrchksum
+ *
+ * Description:
+ *   Add the UDP header at iplen and the pseudo-header sum hsum to the
+ *   payload sum.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_UDP_CHECKSUMS) && !defined(CONFIG_NET_ARCH_CHKSUM)
+static uint16_t udp_hdrchksum(FAR struct net_driver_s *dev,
+                              unsigned int iplen, uint16_t hsum,
+                              uint16_t sum)
+{
+  sum  = chksum(sum, IPBUF(iplen), UDP_HDRLEN);
+  sum += hsum;
+  if (sum < hsum)
+    {
+      sum++; /* carry */
+    }
+
+  return (sum == 0) ? 0xffff : HTONS(sum);
+}
+#endif
+
+/****************************************************************************
+ * Name: udp_ipv4_hdrchksum
+ *
+ * Description:
+ *   Calculate the UDP/IPv4 checksum of the packet in d_buf, the raw sum of
+ *   the payload is given in sum.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_UDP_CHECKSUMS) && defined(CONFIG_NET_IPv4) && \
+    !defined(CONFIG_NET_ARCH_CHKSUM)
+uint16_t udp_ipv4_hdrchksum(FAR struct net_driver_s *dev, uint16_t sum)
+{
+  return udp_hdrchksum(dev, IPv4_HDRLEN,
+                       ipv4_upperlayer_header_chksum(dev, IP_PROTO_UDP),
+                       sum);
+}
+#endif
+
+/****************************************************************************
+ * Name: udp_ipv6_hdrchksum
+ *
+ * Description:
+ *   Calculate the UDP/IPv6 checksum of the packet in d_buf, the raw sum of
+ *   the payload is given in sum.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_UDP_CHECKSUMS) && defined(CONFIG_NET_IPv6) && \
+    !defined(CONFIG_NET_ARCH_CHKSUM)
+uint16_t udp_ipv6_hdrchksum(FAR struct net_driver_s *dev, uint16_t sum)
+{
+  return udp_hdrchksum(dev, IPv6_HDRLEN,
+                       ipv6_upperlayer_header_chksum(dev, IP_PROTO_UDP,
+                                                     IPv6_HDRLEN),
+                       sum);
+}
+#endif
+
 #endif /* CONFIG_NET_UDP */
@@ -497,6 +497,26 @@ uint16_t udp_ipv4_chksum(FAR struct net_driver_s *dev);
 uint16_t udp_ipv6_chksum(FAR struct net_driver_s *dev);
 #endif
 
+/****************************************************************************
+ * Name: udp_ipv4_hdrchksum and udp_ipv6_hdrchksum
+ *
+ * Description:
+ *   Calculate the UDP checksum of the packet in d_buf when the raw sum of
+ *   the payload in d_appdata is already known, e.g. because it was summed
+ *   while being copied in.  Only the pseudo-header and the UDP header are
+ *   read.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_UDP_CHECKSUMS) && !defined(CONFIG_NET_ARCH_CHKSUM)
+#  ifdef CONFIG_NET_IPv4
+uint16_t udp_ipv4_hdrchksum(FAR struct net_driver_s *dev, uint16_t sum);
+#  endif
+#  ifdef CONFIG_NET_IPv6
+uint16_t udp_ipv6_hdrchksum(FAR struct net_driver_s *dev, uint16_t sum);
+#  endif
+#endif
+
 /****************************************************************************
  * Name: icmp_chksum
  *
@@ -62,6 +62,7 @@
 #include "init/init.h"
 #include "instrument/instrument.h"
 #include "tls/tls.h"
+#include "wdog/wdog.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -344,7 +345,6 @@ static void tasklist_initialize(void)
 static void idle_task_initialize(void)
 {
   FAR struct tcb_s *tcb;
-  FAR dq_queue_t *tasklist;
   int i;
 
   memset(g_idletcb, 0, sizeof(g_idletcb));
@@ -420,11 +420,10 @@ static void idle_task_initialize(void)
        */
 
 #ifdef CONFIG_SMP
-      tasklist = TLIST_HEAD(tcb, i);
+      dq_addfirst((FAR dq_entry_t *)tcb, TLIST_HEAD(tcb, i));
 #else
-      tasklist = TLIST_HEAD(tcb);
+      nxsched_rtr_insert(tcb);
 #endif
-      dq_addfirst((FAR dq_entry_t *)tcb, tasklist);
 
       /* Mark the idle task as the running task */
 
@@ -549,6 +548,12 @@ void nx_start(void)
 
   sched_trace_begin();
 
+#ifdef CONFIG_WDOG_PERCPU
+  /* Initialize the per-CPU watchdog queues before any timer is started */
+
+  wd_initialize();
+#endif
+
   /* Initialize RTOS facilities *********************************************/
 
   /* Initialize the semaphore facility.  This has to be done very early
@@ -318,6 +318,29 @@ void nxsched_remove_blocked(FAR struct tcb_s *btcb);
 int  nxsched_set_priority(FAR struct tcb_s *tcb, int sched_priority);
 bool nxsched_reprioritize_rtr(FAR struct tcb_s *tcb, int priority);
 
+/* Constant time ready-to-run list operations (non-SMP only) */
+
+#ifdef CONFIG_SCHED_READYTORUN_BITMAP
+bool nxsched_rtr_insert(FAR struct tcb_s *tcb);
+void nxsched_rtr_remove(FAR struct tcb_s *tcb);
+void nxsched_rtr_setpriority(FAR struct tcb_s *tcb, int priority);
+#else
+#  define nxsched_rtr_insert(tcb) \
+     nxsched_add_prioritized(tcb, list_readytorun())
+#  define nxsched_rtr_remove(tcb) \
+     dq_rem((FAR dq_entry_t *)(tcb), list_readytorun())
+#  define nxsched_rtr_setpriority(tcb, priority) \
+     ((tcb)->sched_priority = (uint8_t)(priority))
+#endif
+
+/* Pulling of waiting tasks by idle CPUs (SMP only) */
+
+#ifdef CONFIG_SCHED_LOAD_BALANCE
+void nxsched_process_balance(uint32_t ticks);
+#else
+#  define nxsched_process_balance(ticks)
+#endif
+
 /* Priority inheritance support */
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
@@ -91,7 +91,7 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
 
   /* Otherwise, add the new task to the ready-to-run task list */
 
-  else if (nxsched_add_prioritized(btcb, list_readytorun()))
+  else if (nxsched_rtr_insert(btcb))
     {
       /* The new btcb was added at the head of the ready-to-run list.  It
        * is now the new active task!
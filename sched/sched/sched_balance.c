@@ -0,0 +1,246 @@
+/****************************************************************************
+ * sched/sched/sched_balance.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sched.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/sched.h>
+
+#include "sched/queue.h"
+#include "sched/sched.h"
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct smp_call_data_s g_balance_data;
+static bool g_balance_initialized;
+static uint32_t g_balance_ticks;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_balance_find
+ *
+ * Description:
+ *   Find a task that 'cpu' may pull from the busiest other CPU.  The
+ *   busiest CPU is the one with the most tasks that are assigned to it
+ *   but not running and that are allowed to run on 'cpu'.  Tasks locked
+ *   to their CPU are never moved.
+ *
+ * Input Parameters:
+ *   cpu - The CPU that is looking for work.
+ *
+ * Returned Value:
+ *   The highest priority candidate of the busiest CPU or NULL if there is
+ *   nothing to pull.
+ *
+ * Assumptions:
+ *   Called within a critical section.
+ *
+ ****************************************************************************/
+
+static FAR struct tcb_s *nxsched_balance_find(int cpu)
+{
+  FAR struct tcb_s *best = NULL;
+  FAR struct tcb_s *first;
+  FAR struct tcb_s *tcb;
+  int maxcount = 0;
+  int count;
+  int i;
+
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
+    {
+      if (i == cpu)
+        {
+          continue;
+        }
+
+      first = NULL;
+      count = 0;
+
+      for (tcb = (FAR struct tcb_s *)g_assignedtasks[i].head;
+           !is_idle_task(tcb); tcb = tcb->flink)
+        {
+          if (tcb->task_state == TSTATE_TASK_ASSIGNED &&
+              (tcb->flags & TCB_FLAG_CPU_LOCKED) == 0 &&
+              CPU_ISSET(cpu, &tcb->affinity))
+            {
+              if (first == NULL)
+                {
+                  first = tcb;
+                }
+
+              count++;
+            }
+        }
+
+      if (count > maxcount)
+        {
+          maxcount = count;
+          best     = first;
+        }
+    }
+
+  return best;
+}
+
+/****************************************************************************
+ * Name: nxsched_balance_idle
+ *
+ * Description:
+ *   Return true if 'cpu' runs its IDLE task and no task is on its way to
+ *   it.
+ *
+ ****************************************************************************/
+
+static bool nxsched_balance_idle(int cpu)
+{
+  return is_idle_task(current_task(cpu)) && g_delivertasks[cpu] == NULL;
+}
+
+/****************************************************************************
+ * Name: nxsched_balance_handler
+ *
+ * Description:
+ *   Runs on an idle CPU and pulls one task from the busiest CPU.  The
+ *   pulled task is not running, so it can be taken off the assigned task
+ *   list of the other CPU without interrupting it.
+ *
+ ****************************************************************************/
+
+static int nxsched_balance_handler(FAR void *arg)
+{
+  FAR struct tcb_s *rtcb;
+  FAR struct tcb_s *tcb;
+  irqstate_t flags;
+  int cpu;
+
+  flags = enter_critical_section();
+  cpu   = this_cpu();
+  rtcb  = this_task();
+
+  /* Things may have changed since the request was sent */
+
+  if (!nxsched_balance_idle(cpu) || nxsched_islocked_tcb(rtcb))
+    {
+      leave_critical_section(flags);
+      return OK;
+    }
+
+  tcb = nxsched_balance_find(cpu);
+  if (tcb != NULL)
+    {
+      /* The task lies between the running task and the IDLE task of the
+       * other CPU.
+       */
+
+      dq_rem_mid(tcb);
+
+      rtcb->task_state = TSTATE_TASK_ASSIGNED;
+      dq_addfirst_nonempty((FAR dq_entry_t *)tcb, list_assignedtasks(cpu));
+
+      tcb->cpu        = cpu;
+      tcb->task_state = TSTATE_TASK_RUNNING;
+      up_update_task(tcb);
+
+      up_switch_context(tcb, rtcb);
+    }
+
+  leave_critical_section(flags);
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_process_balance
+ *
+ * Description:
+ *   Called from the system timer.  Every CONFIG_SCHED_LOAD_BALANCE_INTERVAL
+ *   ticks, ask each idle CPU that could take over a waiting task of
+ *   another CPU to do so.
+ *
+ * Input Parameters:
+ *   ticks - The number of ticks that have elapsed.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxsched_process_balance(uint32_t ticks)
+{
+  irqstate_t flags;
+  cpu_set_t cpuset;
+  int i;
+
+  g_balance_ticks += ticks;
+  if (g_balance_ticks < CONFIG_SCHED_LOAD_BALANCE_INTERVAL)
+    {
+      return;
+    }
+
+  g_balance_ticks = 0;
+  CPU_ZERO(&cpuset);
+
+  flags = enter_critical_section();
+
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
+    {
+      if (nxsched_balance_idle(i) && nxsched_balance_find(i) != NULL)
+        {
+          CPU_SET(i, &cpuset);
+        }
+    }
+
+  /* The call data is shared by all CPUs.  It must only be initialized
+   * once, it may still be queued to some CPU from the previous interval.
+   */
+
+  if (!g_balance_initialized)
+    {
+      nxsched_smp_call_init(&g_balance_data, nxsched_balance_handler,
+                            NULL);
+      g_balance_initialized = true;
+    }
+
+  leave_critical_section(flags);
+
+  if (CPU_COUNT(&cpuset) > 0)
+    {
+      nxsched_smp_call_async(cpuset, &g_balance_data);
+    }
+}
@@ -77,7 +77,9 @@ bool nxsched_merge_pending(void)
   FAR struct tcb_s *ptcb;
   FAR struct tcb_s *pnext;
   FAR struct tcb_s *rtcb;
+#ifndef CONFIG_SCHED_READYTORUN_BITMAP
   FAR struct tcb_s *rprev;
+#endif
   bool ret = false;
 
   /* Initialize the inner search loop */
@@ -97,6 +99,22 @@ bool nxsched_merge_pending(void)
         {
           pnext = ptcb->flink;
 
+#ifdef CONFIG_SCHED_READYTORUN_BITMAP
+          if (nxsched_rtr_insert(ptcb))
+            {
+              /* Special case: ptcb was inserted at the head of the list */
+
+              rtcb              = ptcb->flink;
+              rtcb->task_state  = TSTATE_TASK_READYTORUN;
+              ptcb->task_state  = TSTATE_TASK_RUNNING;
+              up_update_task(ptcb);
+              ret               = true;
+            }
+          else
+            {
+              ptcb->task_state  = TSTATE_TASK_READYTORUN;
+            }
+#else
           /* REVISIT:  Why don't we just remove the ptcb from pending task
            * list and call nxsched_add_readytorun?
            */
@@ -151,6 +169,7 @@ bool nxsched_merge_pending(void)
           /* Set up for the next time through */
 
           rtcb = ptcb;
+#endif
         }
 
       /* Mark the input list empty */
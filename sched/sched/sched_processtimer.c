@@ -192,6 +192,10 @@ void nxsched_process_timer(void)
 
   nxsched_process_scheduler();
 
+  /* Let idle CPUs take over work queued on busy CPUs */
+
+  nxsched_process_balance(1);
+
   /* Process watchdogs */
 
   wd_timer(clock_systime_ticks());
@@ -32,6 +32,8 @@
 
 #include <nuttx/arch.h>
 #include <nuttx/sched.h>
+#include <nuttx/tls.h>
+#include <nuttx/mm/mm.h>
 
 #include "task/task.h"
 #include "sched/sched.h"
@@ -136,6 +138,14 @@ int nxsched_release_tcb(FAR struct tcb_s *tcb, uint8_t ttype)
 
       if (tcb->stack_alloc_ptr)
         {
+#if defined(CONFIG_MM_TCACHE) && defined(CONFIG_BUILD_FLAT)
+          /* Return the user heap blocks still cached by a thread that
+           * did not leave through pthread_exit() or exit().
+           */
+
+          umm_tcache_destroy(nxsched_get_tls(tcb));
+#endif
+
           up_release_stack(tcb, ttype);
         }
 
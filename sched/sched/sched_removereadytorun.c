@@ -64,11 +64,8 @@
 #ifndef CONFIG_SMP
 bool nxsched_remove_readytorun(FAR struct tcb_s *rtcb)
 {
-  FAR dq_queue_t *tasklist;
   bool doswitch = false;
 
-  tasklist = TLIST_HEAD(rtcb);
-
   /* Check if the TCB to be removed is at the head of the ready to run list.
    * There is only one list, g_readytorun, and it always contains the
    * currently running task.  If we are removing the head of this list,
@@ -93,7 +90,7 @@ bool nxsched_remove_readytorun(FAR struct tcb_s *rtcb)
    * is always the g_readytorun list.
    */
 
-  dq_rem((FAR dq_entry_t *)rtcb, tasklist);
+  nxsched_rtr_remove(rtcb);
 
   /* Since the TCB is not in any list, it is now invalid */
 
@@ -0,0 +1,284 @@
+/****************************************************************************
+ * sched/sched/sched_rtrbitmap.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <strings.h>
+#include <assert.h>
+
+#include <nuttx/queue.h>
+#include <nuttx/sched.h>
+
+#include "sched/sched.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* One bit per priority level, grouped into 32-bit words.  A second level
+ * bitmap tells which of the words are non-zero, so that the search for the
+ * next populated priority never scans more than two words.
+ */
+
+#define RTR_NPRIO            (SCHED_PRIORITY_MAX + 1)
+#define RTR_NWORDS           ((RTR_NPRIO + 31) / 32)
+#define RTR_WORD(p)          ((p) >> 5)
+#define RTR_BIT(p)           (1u << ((p) & 31))
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The ready-to-run list is still one list sorted by priority, but it is
+ * viewed as the concatenation of one FIFO per priority level.  For each
+ * non-empty level, g_rtrtail[] holds the last TCB of that level and the
+ * level is marked in g_rtrmap[].  Entries of empty levels are stale and
+ * must not be accessed.
+ */
+
+static FAR struct tcb_s *g_rtrtail[RTR_NPRIO];
+static uint32_t g_rtrmap[RTR_NWORDS];
+static uint32_t g_rtrgroup;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_rtr_mark
+ *
+ * Description:
+ *   Mark a priority level as populated.
+ *
+ ****************************************************************************/
+
+static inline_function void nxsched_rtr_mark(int priority)
+{
+  g_rtrmap[RTR_WORD(priority)] |= RTR_BIT(priority);
+  g_rtrgroup |= 1u << RTR_WORD(priority);
+}
+
+/****************************************************************************
+ * Name: nxsched_rtr_clear
+ *
+ * Description:
+ *   Mark a priority level as empty.
+ *
+ ****************************************************************************/
+
+static inline_function void nxsched_rtr_clear(int priority)
+{
+  g_rtrmap[RTR_WORD(priority)] &= ~RTR_BIT(priority);
+  if (g_rtrmap[RTR_WORD(priority)] == 0)
+    {
+      g_rtrgroup &= ~(1u << RTR_WORD(priority));
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_rtr_above
+ *
+ * Description:
+ *   Return the lowest populated priority level that is greater than or
+ *   equal to 'priority', or -1 if there is none.  A new TCB of 'priority'
+ *   goes right after the last TCB of that level.
+ *
+ ****************************************************************************/
+
+static int nxsched_rtr_above(int priority)
+{
+  uint32_t word = RTR_WORD(priority);
+  uint32_t bits;
+
+  bits = g_rtrmap[word] & (UINT32_MAX << (priority & 31));
+  if (bits == 0)
+    {
+      bits = g_rtrgroup & ~((2u << word) - 1);
+      if (bits == 0)
+        {
+          return -1;
+        }
+
+      word = ffs(bits) - 1;
+      bits = g_rtrmap[word];
+    }
+
+  return (word << 5) + ffs(bits) - 1;
+}
+
+/****************************************************************************
+ * Name: nxsched_rtr_unindex
+ *
+ * Description:
+ *   Drop a TCB from the tail of its priority level.  The TCB itself stays
+ *   where it is in the ready-to-run list.
+ *
+ ****************************************************************************/
+
+static void nxsched_rtr_unindex(FAR struct tcb_s *tcb, int priority)
+{
+  FAR struct tcb_s *prev;
+
+  if (g_rtrtail[priority] == tcb)
+    {
+      prev = tcb->blink;
+      if (prev != NULL && prev->sched_priority == priority)
+        {
+          g_rtrtail[priority] = prev;
+        }
+      else
+        {
+          nxsched_rtr_clear(priority);
+        }
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_rtr_insert
+ *
+ * Description:
+ *   Add a TCB to the ready-to-run list behind all other TCBs of the same
+ *   priority.  This has the same effect as nxsched_add_prioritized() on
+ *   g_readytorun, but in constant time.
+ *
+ * Input Parameters:
+ *   tcb - The TCB to add.  It must not be in any list.
+ *
+ * Returned Value:
+ *   true if the TCB was added at the head of the ready-to-run list.
+ *
+ * Assumptions:
+ *   Called within a critical section.
+ *
+ ****************************************************************************/
+
+bool nxsched_rtr_insert(FAR struct tcb_s *tcb)
+{
+  FAR dq_queue_t *list = list_readytorun();
+  FAR struct tcb_s *prev = NULL;
+  FAR struct tcb_s *next;
+  int priority = tcb->sched_priority;
+  int level;
+
+  level = nxsched_rtr_above(priority);
+  if (level >= 0)
+    {
+      prev = g_rtrtail[level];
+      next = prev->flink;
+      prev->flink = tcb;
+    }
+  else
+    {
+      next = (FAR struct tcb_s *)list->head;
+      list->head = (FAR dq_entry_t *)tcb;
+    }
+
+  tcb->blink = prev;
+  tcb->flink = next;
+
+  if (next != NULL)
+    {
+      next->blink = tcb;
+    }
+  else
+    {
+      list->tail = (FAR dq_entry_t *)tcb;
+    }
+
+  g_rtrtail[priority] = tcb;
+  nxsched_rtr_mark(priority);
+
+  return prev == NULL;
+}
+
+/****************************************************************************
+ * Name: nxsched_rtr_remove
+ *
+ * Description:
+ *   Remove a TCB from the ready-to-run list in constant time.
+ *
+ * Input Parameters:
+ *   tcb - The TCB to remove.  It must be in the ready-to-run list.
+ *
+ * Assumptions:
+ *   Called within a critical section.
+ *
+ ****************************************************************************/
+
+void nxsched_rtr_remove(FAR struct tcb_s *tcb)
+{
+  nxsched_rtr_unindex(tcb, tcb->sched_priority);
+  dq_rem((FAR dq_entry_t *)tcb, list_readytorun());
+}
+
+/****************************************************************************
+ * Name: nxsched_rtr_setpriority
+ *
+ * Description:
+ *   Change the priority of a TCB in the ready-to-run list without moving
+ *   it.  The caller must guarantee that the list stays sorted, which is
+ *   the case when the priority of the running task is raised, or lowered
+ *   no further than the priority of the next task.
+ *
+ * Input Parameters:
+ *   tcb      - The TCB to change.
+ *   priority - The new priority.
+ *
+ * Assumptions:
+ *   Called within a critical section.
+ *
+ ****************************************************************************/
+
+void nxsched_rtr_setpriority(FAR struct tcb_s *tcb, int priority)
+{
+  FAR struct tcb_s *next;
+
+  if (tcb->sched_priority == priority)
+    {
+      return;
+    }
+
+  nxsched_rtr_unindex(tcb, tcb->sched_priority);
+  tcb->sched_priority = (uint8_t)priority;
+
+  /* The TCB becomes the tail of its new level unless the next TCB in the
+   * list also belongs to that level.
+   */
+
+  next = tcb->flink;
+  if ((g_rtrmap[RTR_WORD(priority)] & RTR_BIT(priority)) == 0 ||
+      next == NULL || next->sched_priority != priority)
+    {
+      g_rtrtail[priority] = tcb;
+      nxsched_rtr_mark(priority);
+    }
+}
@@ -28,12 +28,14 @@
 
 #include <sys/types.h>
 #include <sched.h>
+#include <strings.h>
 #include <assert.h>
 #include <errno.h>
 
 #include <nuttx/arch.h>
 
 #include "sched/sched.h"
+#include "wdog/wdog.h"
 
 /****************************************************************************
  * Public Functions
@@ -148,6 +150,19 @@ int nxsched_set_affinity(pid_t pid, size_t cpusetsize,
         }
     }
 
+#ifdef CONFIG_WDOG_PERCPU
+  /* A pending timeout of the task expires on the CPU that started it.
+   * Move it to a CPU that the task may still run on.
+   */
+
+  if (WDOG_ISACTIVE(&tcb->waitdog) &&
+      (tcb->affinity & (1 << tcb->waitdog.cpu)) == 0)
+    {
+      wd_migrate(&tcb->waitdog, (tcb->affinity & (1 << tcb->cpu)) != 0 ?
+                                tcb->cpu : ffs(tcb->affinity) - 1);
+    }
+#endif
+
 errout_with_csection:
   leave_critical_section(flags);
 
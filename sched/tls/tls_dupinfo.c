@@ -70,5 +70,12 @@ int tls_dup_info(FAR struct tcb_s *dst, FAR struct tcb_s *src)
   /* Attach per-task info in group to TLS */
 
   info->tl_task = dst->group->tg_info;
+
+#ifdef CONFIG_MM_TCACHE
+  /* The heap cache belongs to the source thread */
+
+  info->tl_tcache = NULL;
+#endif
+
   return OK;
 }
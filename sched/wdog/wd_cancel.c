@@ -62,14 +62,28 @@ int wd_cancel(FAR struct wdog_s *wdog)
 {
   irqstate_t flags;
   bool head;
+  int cpu;
 
-  flags = spin_lock_irqsave(&g_wdspinlock);
+#ifdef CONFIG_WDOG_PERCPU
+  if (wdog == NULL)
+    {
+      return -EINVAL;
+    }
+
+  /* Lock the queue of the CPU that started the watchdog */
+
+  flags = up_irq_save();
+  cpu   = wd_lock_queue(wdog);
+#else
+  cpu   = 0;
+  flags = spin_lock_irqsave(wd_spinlock(cpu));
+#endif
 
   /* Make sure that the watchdog is valid and still active. */
 
   if (wdog == NULL || !WDOG_ISACTIVE(wdog))
     {
-      spin_unlock_irqrestore(&g_wdspinlock, flags);
+      spin_unlock_irqrestore(wd_spinlock(cpu), flags);
       return -EINVAL;
     }
 
@@ -80,16 +94,20 @@ int wd_cancel(FAR struct wdog_s *wdog)
    * cancellation is complete
    */
 
-  head = list_is_head(&g_wdactivelist, &wdog->node);
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+  head = wd_wheel_delete(wdog);
+#else
+  head = list_is_head(wd_activelist(cpu), &wdog->node);
 
   /* Now, remove the watchdog from the timer queue */
 
   list_delete(&wdog->node);
+#endif
 
   /* Mark the watchdog inactive */
 
   wdog->func = NULL;
-  spin_unlock_irqrestore(&g_wdspinlock, flags);
+  spin_unlock_irqrestore(wd_spinlock(cpu), flags);
 
   if (head)
     {
@@ -34,6 +34,11 @@
  * Public Data
  ****************************************************************************/
 
+#ifdef CONFIG_WDOG_PERCPU
+/* One queue of active watchdogs per CPU, initialized by wd_initialize() */
+
+struct wd_queue_s g_wdqueue[CONFIG_SMP_NCPUS];
+#else
 spinlock_t g_wdspinlock = SP_UNLOCKED;
 
 /* The g_wdactivelist data structure is a singly linked list ordered by
@@ -41,8 +46,41 @@ spinlock_t g_wdspinlock = SP_UNLOCKED;
  * this linked list are removed and the function is called.
  */
 
+#  ifndef CONFIG_WDOG_TIMER_WHEEL
 struct list_node g_wdactivelist = LIST_INITIAL_VALUE(g_wdactivelist);
+#  endif
+#endif
 
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
+
+#ifdef CONFIG_WDOG_PERCPU
+/****************************************************************************
+ * Name: wd_initialize
+ *
+ * Description:
+ *   Initialize the per-CPU watchdog queues.  Called once during OS
+ *   initialization before any watchdog is started.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void wd_initialize(void)
+{
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      spin_lock_init(&g_wdqueue[cpu].lock);
+      list_initialize(&g_wdqueue[cpu].list);
+      nxsched_smp_call_init(&g_wdqueue[cpu].call, wd_smp_expiration,
+                            (FAR void *)(uintptr_t)cpu);
+    }
+}
+#endif
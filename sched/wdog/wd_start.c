@@ -90,7 +90,13 @@
  ****************************************************************************/
 
 #ifdef CONFIG_SCHED_TICKLESS
+#  ifdef CONFIG_WDOG_PERCPU
+static unsigned int g_wdtimernested[CONFIG_SMP_NCPUS];
+#    define WDOG_NESTED(cpu) g_wdtimernested[cpu]
+#  else
 static unsigned int g_wdtimernested;
+#    define WDOG_NESTED(cpu) g_wdtimernested
+#  endif
 #endif
 
 /****************************************************************************
@@ -105,6 +111,7 @@ static unsigned int g_wdtimernested;
  *   run. If so, remove the watchdog from the list and execute it.
  *
  * Input Parameters:
+ *   cpu   - The CPU whose watchdog queue is processed
  *   ticks - current time in ticks
  *
  * Returned Value:
@@ -112,30 +119,34 @@ static unsigned int g_wdtimernested;
  *
  ****************************************************************************/
 
-static inline_function void wd_expiration(clock_t ticks)
+static inline_function void wd_expiration(int cpu, clock_t ticks)
 {
   FAR struct wdog_s *wdog;
   irqstate_t         flags;
   wdentry_t          func;
   wdparm_t           arg;
 
-  flags = spin_lock_irqsave(&g_wdspinlock);
+  flags = spin_lock_irqsave(wd_spinlock(cpu));
 
 #ifdef CONFIG_SCHED_TICKLESS
   /* Increment the nested watchdog timer count to handle cases where wd_start
    * is called in the watchdog callback functions.
    */
 
-  g_wdtimernested++;
+  WDOG_NESTED(cpu)++;
 #endif
 
   /* Process the watchdog at the head of the list as well as any
    * other watchdogs that became ready to run at this time
    */
 
-  while (!list_is_empty(&g_wdactivelist))
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+  while ((wdog = wd_wheel_expired(ticks)) != NULL)
+    {
+#else
+  while (!list_is_empty(wd_activelist(cpu)))
     {
-      wdog = list_first_entry(&g_wdactivelist, struct wdog_s, node);
+      wdog = list_first_entry(wd_activelist(cpu), struct wdog_s, node);
 
       /* Check if expected time is expired */
 
@@ -147,6 +158,7 @@ static inline_function void wd_expiration(clock_t ticks)
       /* Remove the watchdog from the head of the list */
 
       list_delete(&wdog->node);
+#endif
 
       /* Indicate that the watchdog is no longer active. */
 
@@ -157,30 +169,31 @@ static inline_function void wd_expiration(clock_t ticks)
       /* Execute the watchdog function */
 
       up_setpicbase(wdog->picbase);
-      spin_unlock_irqrestore(&g_wdspinlock, flags);
+      spin_unlock_irqrestore(wd_spinlock(cpu), flags);
 
       CALL_FUNC(func, arg);
 
-      flags = spin_lock_irqsave(&g_wdspinlock);
+      flags = spin_lock_irqsave(wd_spinlock(cpu));
     }
 
 #ifdef CONFIG_SCHED_TICKLESS
   /* Decrement the nested watchdog timer count */
 
-  g_wdtimernested--;
+  WDOG_NESTED(cpu)--;
 #endif
 
-  spin_unlock_irqrestore(&g_wdspinlock, flags);
+  spin_unlock_irqrestore(wd_spinlock(cpu), flags);
 }
 
 /****************************************************************************
  * Name: wd_insert
  *
  * Description:
- *   Insert the timer into the global list to ensure that
+ *   Insert the timer into the active list to ensure that
  *   the list is sorted in increasing order of expiration absolute time.
  *
  * Input Parameters:
+ *   cpu      - The CPU whose watchdog queue receives the timer
  *   wdog     - Watchdog ID
  *   expired  - expired absolute time in clock ticks
  *   wdentry  - Function to call on timeout
@@ -194,8 +207,25 @@ static inline_function void wd_expiration(clock_t ticks)
  *
  ****************************************************************************/
 
+#ifdef CONFIG_WDOG_TIMER_WHEEL
 static inline_function
-bool wd_insert(FAR struct wdog_s *wdog, clock_t expired,
+bool wd_insert(int cpu, FAR struct wdog_s *wdog, clock_t expired,
+               wdentry_t wdentry, wdparm_t arg)
+{
+  UNUSED(cpu);
+
+  wdog->func = wdentry;
+  up_getpicbase(&wdog->picbase);
+  wdog->arg = arg;
+  wdog->expired = expired;
+
+  /* Hash the watchdog into the timer wheel in constant time */
+
+  return wd_wheel_insert(wdog);
+}
+#else
+static inline_function
+bool wd_insert(int cpu, FAR struct wdog_s *wdog, clock_t expired,
                wdentry_t wdentry, wdparm_t arg)
 {
   FAR struct wdog_s *curr;
@@ -203,9 +233,9 @@ bool wd_insert(FAR struct wdog_s *wdog, clock_t expired,
 
   /* Traverse the watchdog list */
 
-  head = list_first_entry(&g_wdactivelist, struct wdog_s, node);
+  head = list_first_entry(wd_activelist(cpu), struct wdog_s, node);
 
-  list_for_every_entry(&g_wdactivelist, curr, struct wdog_s, node)
+  list_for_every_entry(wd_activelist(cpu), curr, struct wdog_s, node)
     {
       /* Until curr->expired has not timed out relative to expired */
 
@@ -216,7 +246,7 @@ bool wd_insert(FAR struct wdog_s *wdog, clock_t expired,
     }
 
   /* There are two cases:
-   * - Traverse to the end, where curr == &g_wdactivelist.
+   * - Traverse to the end, where curr == wd_activelist(cpu).
    * - Find a curr such that curr->expected has not timed out
    * relative to expired.
    * In either case 1 or 2, we just insert the wdog before curr.
@@ -228,11 +258,161 @@ bool wd_insert(FAR struct wdog_s *wdog, clock_t expired,
   up_getpicbase(&wdog->picbase);
   wdog->arg = arg;
   wdog->expired = expired;
+#ifdef CONFIG_WDOG_PERCPU
+  wdog->cpu = cpu;
+#endif
 
   /* Return whether the head of the watchdog list has changed. */
 
   return head == curr;
 }
+#endif
+
+#ifdef CONFIG_WDOG_PERCPU
+/****************************************************************************
+ * Name: wd_lock_pair
+ *
+ * Description:
+ *   Lock both the queue of the CPU that currently owns the watchdog and
+ *   the queue of 'cpu'.  The locks are always taken in CPU order to avoid
+ *   deadlocks between CPUs moving watchdogs in opposite directions.
+ *
+ * Returned Value:
+ *   The CPU index of the current owner.
+ *
+ * Assumptions:
+ *   Local interrupts are disabled.
+ *
+ ****************************************************************************/
+
+static inline_function int wd_lock_pair(FAR struct wdog_s *wdog, int cpu)
+{
+  int owner;
+
+  for (; ; )
+    {
+      owner = wdog->cpu;
+      spin_lock(wd_spinlock(MIN(owner, cpu)));
+      if (owner != cpu)
+        {
+          spin_lock(wd_spinlock(MAX(owner, cpu)));
+        }
+
+      if (owner == wdog->cpu)
+        {
+          return owner;
+        }
+
+      if (owner != cpu)
+        {
+          spin_unlock(wd_spinlock(MAX(owner, cpu)));
+        }
+
+      spin_unlock(wd_spinlock(MIN(owner, cpu)));
+    }
+}
+
+static inline_function void wd_unlock_pair(int owner, int cpu)
+{
+  if (owner != cpu)
+    {
+      spin_unlock(wd_spinlock(owner));
+    }
+
+  spin_unlock(wd_spinlock(cpu));
+}
+
+/****************************************************************************
+ * Name: wd_requeue
+ *
+ * Description:
+ *   (Re)start the watchdog on the queue of 'cpu', removing it first from
+ *   the queue it is currently active on, if any.
+ *
+ * Returned Value:
+ *   Whether the interval timer needs to be reassessed.
+ *
+ * Assumptions:
+ *   Local interrupts are disabled.
+ *
+ ****************************************************************************/
+
+static bool wd_requeue(int cpu, FAR struct wdog_s *wdog, clock_t ticks,
+                       wdentry_t wdentry, wdparm_t arg)
+{
+  bool reassess = false;
+  int owner;
+
+  owner = wd_lock_pair(wdog, cpu);
+
+  if (WDOG_ISACTIVE(wdog))
+    {
+      reassess |= list_is_head(wd_activelist(owner), &wdog->node);
+      list_delete(&wdog->node);
+      wdog->func = NULL;
+    }
+
+  reassess |= wd_insert(cpu, wdog, ticks, wdentry, arg);
+
+#ifdef CONFIG_SCHED_TICKLESS
+  /* The timer is reassessed anyway when leaving wd_timer() */
+
+  reassess &= !WDOG_NESTED(cpu);
+#endif
+
+  wd_unlock_pair(owner, cpu);
+  return reassess;
+}
+
+/****************************************************************************
+ * Name: wd_dispatch
+ *
+ * Description:
+ *   Process the expired watchdogs of this CPU and ask every other CPU with
+ *   expired watchdogs to process its own queue.
+ *
+ * Input Parameters:
+ *   ticks - current time in ticks
+ *
+ ****************************************************************************/
+
+static void wd_dispatch(clock_t ticks)
+{
+  FAR struct wdog_s *wdog;
+  irqstate_t flags;
+  bool expired;
+  int me = this_cpu();
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      if (cpu == me)
+        {
+          continue;
+        }
+
+      flags = spin_lock_irqsave(wd_spinlock(cpu));
+      expired = false;
+
+      if (!list_is_empty(wd_activelist(cpu)))
+        {
+          wdog = list_first_entry(wd_activelist(cpu), struct wdog_s, node);
+          expired = clock_compare(wdog->expired, ticks);
+        }
+
+      spin_unlock_irqrestore(wd_spinlock(cpu), flags);
+
+      if (expired)
+        {
+          nxsched_smp_call_single_async(cpu, &g_wdqueue[cpu].call);
+        }
+    }
+
+  wd_expiration(me, ticks);
+}
+#else
+#  define wd_dispatch(ticks) wd_expiration(0, ticks)
+#endif
 
 /****************************************************************************
  * Public Functions
@@ -292,18 +472,36 @@ int wd_start_abstick(FAR struct wdog_s *wdog, clock_t ticks,
    * the critical section is established.
    */
 
+#if defined(CONFIG_WDOG_PERCPU)
+  /* Queue the watchdog on the CPU that starts it, so that it will also
+   * expire on this CPU.
+   */
+
+  flags = up_irq_save();
+  reassess = wd_requeue(this_cpu(), wdog, ticks, wdentry, arg);
+  up_irq_restore(flags);
+
+  if (reassess)
+    {
+      nxsched_reassess_timer();
+    }
+#elif defined(CONFIG_SCHED_TICKLESS)
   flags = spin_lock_irqsave(&g_wdspinlock);
-#ifdef CONFIG_SCHED_TICKLESS
+
   /* We need to reassess timer if the watchdog list head has changed. */
 
   if (WDOG_ISACTIVE(wdog))
     {
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+      reassess |= wd_wheel_delete(wdog);
+#else
       reassess |= list_is_head(&g_wdactivelist, &wdog->node);
       list_delete(&wdog->node);
+#endif
       wdog->func = NULL;
     }
 
-  reassess |= wd_insert(wdog, ticks, wdentry, arg);
+  reassess |= wd_insert(0, wdog, ticks, wdentry, arg);
 
   if (!g_wdtimernested && reassess)
     {
@@ -322,15 +520,21 @@ int wd_start_abstick(FAR struct wdog_s *wdog, clock_t ticks,
 #else
   UNUSED(reassess);
 
+  flags = spin_lock_irqsave(&g_wdspinlock);
+
   /* Check if the watchdog has been started. If so, delete it. */
 
   if (WDOG_ISACTIVE(wdog))
     {
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+      wd_wheel_delete(wdog);
+#else
       list_delete(&wdog->node);
+#endif
       wdog->func = NULL;
     }
 
-  wd_insert(wdog, ticks, wdentry, arg);
+  wd_insert(0, wdog, ticks, wdentry, arg);
   spin_unlock_irqrestore(&g_wdspinlock, flags);
 #endif
 
@@ -416,7 +620,14 @@ int wd_start(FAR struct wdog_s *wdog, clock_t delay,
 #ifdef CONFIG_SCHED_TICKLESS
 clock_t wd_timer(clock_t ticks, bool noswitches)
 {
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+  clock_t next;
+#else
   FAR struct wdog_s *wdog;
+  bool found = false;
+  sclock_t delay;
+  int cpu;
+#endif
   irqstate_t flags;
   sclock_t ret;
 
@@ -424,27 +635,58 @@ clock_t wd_timer(clock_t ticks, bool noswitches)
 
   if (!noswitches)
     {
-      wd_expiration(ticks);
+      wd_dispatch(ticks);
     }
 
-  flags = spin_lock_irqsave(&g_wdspinlock);
-
   /* Return the delay for the next watchdog to expire */
 
-  if (list_is_empty(&g_wdactivelist))
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+  flags = spin_lock_irqsave(&g_wdspinlock);
+
+  if (!wd_wheel_next(&next))
     {
       spin_unlock_irqrestore(&g_wdspinlock, flags);
       return 0;
     }
 
-  /* Notice that if noswitches, expired - g_wdtickbase
-   * may get negative value.
+  /* The wheel may report the cascade time of an upper level slot, which
+   * is never later than the expiration of any watchdog in that slot.
    */
 
-  wdog = list_first_entry(&g_wdactivelist, struct wdog_s, node);
-  ret = wdog->expired - ticks;
+  ret = next - ticks;
 
   spin_unlock_irqrestore(&g_wdspinlock, flags);
+#else
+  ret = 0;
+
+  for (cpu = 0; cpu < WDOG_NQUEUES; cpu++)
+    {
+      flags = spin_lock_irqsave(wd_spinlock(cpu));
+
+      if (!list_is_empty(wd_activelist(cpu)))
+        {
+          /* Notice that if noswitches, expired - g_wdtickbase
+           * may get negative value.
+           */
+
+          wdog  = list_first_entry(wd_activelist(cpu), struct wdog_s, node);
+          delay = wdog->expired - ticks;
+          if (!found || delay < ret)
+            {
+              ret = delay;
+            }
+
+          found = true;
+        }
+
+      spin_unlock_irqrestore(wd_spinlock(cpu), flags);
+    }
+
+  if (!found)
+    {
+      return 0;
+    }
+#endif
 
   /* Return the delay for the next watchdog to expire */
 
@@ -456,6 +698,99 @@ void wd_timer(clock_t ticks)
 {
   /* Check if there are any active watchdogs to process */
 
-  wd_expiration(ticks);
+  wd_dispatch(ticks);
 }
 #endif /* CONFIG_SCHED_TICKLESS */
+
+#ifdef CONFIG_WDOG_PERCPU
+/****************************************************************************
+ * Name: wd_smp_expiration
+ *
+ * Description:
+ *   SMP call handler that processes the expired watchdogs of the CPU it
+ *   runs on.  wd_timer() sends it to other CPUs whose queue has expired
+ *   watchdogs.
+ *
+ * Input Parameters:
+ *   arg - The CPU index of the queue, which is always this CPU
+ *
+ * Returned Value:
+ *   Always returns OK
+ *
+ ****************************************************************************/
+
+int wd_smp_expiration(FAR void *arg)
+{
+  int cpu = (int)(uintptr_t)arg;
+
+  DEBUGASSERT(cpu == this_cpu());
+
+  wd_expiration(cpu, clock_systime_ticks());
+
+  /* The watchdog callbacks may have restarted watchdogs on this CPU
+   * without reassessing the interval timer.
+   */
+
+  nxsched_reassess_timer();
+  return OK;
+}
+
+/****************************************************************************
+ * Name: wd_migrate
+ *
+ * Description:
+ *   Move an active watchdog to the queue of another CPU, e.g. after the
+ *   affinity of the thread that armed it has changed.  Nothing is done if
+ *   the watchdog is not active or is already queued on that CPU.
+ *
+ * Input Parameters:
+ *   wdog - Watchdog ID
+ *   cpu  - The CPU that should handle the expiration
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void wd_migrate(FAR struct wdog_s *wdog, int cpu)
+{
+  irqstate_t flags;
+  bool reassess = false;
+  int owner;
+
+  DEBUGASSERT(wdog != NULL && cpu >= 0 && cpu < CONFIG_SMP_NCPUS);
+
+  flags = up_irq_save();
+  owner = wd_lock_pair(wdog, cpu);
+
+  if (WDOG_ISACTIVE(wdog) && owner != cpu)
+    {
+#ifdef CONFIG_PIC
+      FAR void *picbase = wdog->picbase;
+#endif
+
+      /* Both queues are locked, so the watchdog never appears inactive
+       * to wd_cancel() while it is moved.
+       */
+
+      reassess = list_is_head(wd_activelist(owner), &wdog->node);
+      list_delete(&wdog->node);
+      reassess |= wd_insert(cpu, wdog, wdog->expired, wdog->func,
+                            wdog->arg);
+
+#ifdef CONFIG_PIC
+      /* Keep the address environment of the thread that started it */
+
+      wdog->picbase = picbase;
+#endif
+    }
+
+  wd_unlock_pair(owner, cpu);
+  up_irq_restore(flags);
+
+  if (reassess)
+    {
+      nxsched_reassess_timer();
+    }
+}
+#endif /* CONFIG_WDOG_PERCPU */
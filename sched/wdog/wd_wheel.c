@@ -0,0 +1,414 @@
+/****************************************************************************
+ * sched/wdog/wd_wheel.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <strings.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/list.h>
+#include <nuttx/wdog.h>
+
+#include "wdog/wdog.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Each level of the wheel has 32 slots so that the pending slots of one
+ * level fit into a single 32-bit bitmap.  A slot on level 'n' covers
+ * 2^(5 * n) ticks and the whole wheel covers WDOG_WHEEL_RANGE ticks.
+ * Watchdogs further away than that are parked in the top level and are
+ * simply re-inserted when that slot is cascaded.
+ */
+
+#define WDOG_WHEEL_BITS        5
+#define WDOG_WHEEL_SLOTS       (1 << WDOG_WHEEL_BITS)
+#define WDOG_WHEEL_MASK        (WDOG_WHEEL_SLOTS - 1)
+#define WDOG_WHEEL_LEVELS      CONFIG_WDOG_TIMER_WHEEL_LEVELS
+#define WDOG_WHEEL_SHIFT(l)    ((l) * WDOG_WHEEL_BITS)
+#define WDOG_WHEEL_SPAN(l)     ((clock_t)1 << WDOG_WHEEL_SHIFT(l))
+#define WDOG_WHEEL_RANGE       WDOG_WHEEL_SPAN(WDOG_WHEEL_LEVELS)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct wd_wheel_s
+{
+  clock_t          curr;                       /* Next tick to process */
+  uint32_t         pending[WDOG_WHEEL_LEVELS]; /* Non-empty slot bitmap */
+  struct list_node slots[WDOG_WHEEL_LEVELS][WDOG_WHEEL_SLOTS];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The slot lists are initialized lazily when they first become non-empty;
+ * a clear bit in 'pending' means the corresponding slot must not be
+ * accessed.
+ */
+
+static struct wd_wheel_s g_wdwheel;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_empty
+ *
+ * Description:
+ *   Return true if no watchdog is armed.
+ *
+ ****************************************************************************/
+
+static bool wd_wheel_empty(void)
+{
+  int level;
+
+  for (level = 0; level < WDOG_WHEEL_LEVELS; level++)
+    {
+      if (g_wdwheel.pending[level] != 0)
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_add
+ *
+ * Description:
+ *   Hash the watchdog into the wheel slot that will be processed (or
+ *   cascaded) first at or before its expiration time.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_add(FAR struct wdog_s *wdog)
+{
+  FAR struct list_node *slot;
+  clock_t expired = wdog->expired;
+  clock_t delta = expired - g_wdwheel.curr;
+  unsigned int level = 0;
+  unsigned int index;
+
+  if ((sclock_t)delta < 0)
+    {
+      /* Already expired, run on the next tick processed */
+
+      expired = g_wdwheel.curr;
+      delta   = 0;
+    }
+  else if (delta >= WDOG_WHEEL_RANGE)
+    {
+      /* Beyond the range of the wheel, park it in the top level */
+
+      expired = g_wdwheel.curr + WDOG_WHEEL_RANGE - 1;
+      delta   = WDOG_WHEEL_RANGE - 1;
+    }
+
+  while (level < WDOG_WHEEL_LEVELS - 1 &&
+         delta >= WDOG_WHEEL_SPAN(level + 1))
+    {
+      level++;
+    }
+
+  index = (expired >> WDOG_WHEEL_SHIFT(level)) & WDOG_WHEEL_MASK;
+  slot  = &g_wdwheel.slots[level][index];
+
+  if ((g_wdwheel.pending[level] & (1u << index)) == 0)
+    {
+      list_initialize(slot);
+      g_wdwheel.pending[level] |= 1u << index;
+    }
+
+  list_add_tail(slot, &wdog->node);
+}
+
+/****************************************************************************
+ * Name: wd_wheel_cascade
+ *
+ * Description:
+ *   Redistribute the watchdogs of every upper level slot that expires at
+ *   'ticks' into the lower levels.  Levels are processed from the top so
+ *   that watchdogs moved down into a slot that is itself due at 'ticks'
+ *   are cascaded again.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_cascade(clock_t ticks)
+{
+  FAR struct list_node *slot;
+  FAR struct wdog_s *wdog;
+  unsigned int index;
+  int level;
+
+  for (level = WDOG_WHEEL_LEVELS - 1; level > 0; level--)
+    {
+      if ((ticks & (WDOG_WHEEL_SPAN(level) - 1)) != 0)
+        {
+          continue;
+        }
+
+      index = (ticks >> WDOG_WHEEL_SHIFT(level)) & WDOG_WHEEL_MASK;
+      if ((g_wdwheel.pending[level] & (1u << index)) == 0)
+        {
+          continue;
+        }
+
+      slot = &g_wdwheel.slots[level][index];
+      g_wdwheel.pending[level] &= ~(1u << index);
+
+      while (!list_is_empty(slot))
+        {
+          wdog = list_first_entry(slot, struct wdog_s, node);
+          list_delete(&wdog->node);
+          wd_wheel_add(wdog);
+        }
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_next
+ *
+ * Description:
+ *   Return the earliest tick at which a slot of the wheel must be
+ *   processed.  For the lowest level this is the exact expiration time,
+ *   for the upper levels it is the time of the cascade, which is never
+ *   later than the expiration of the watchdogs in the slot.
+ *
+ * Returned Value:
+ *   False if no watchdog is active.
+ *
+ * Assumptions:
+ *   Called with g_wdspinlock held.
+ *
+ ****************************************************************************/
+
+bool wd_wheel_next(FAR clock_t *next)
+{
+  bool found = false;
+  uint32_t pending;
+  clock_t ticks;
+  clock_t start;
+  int level;
+  int shift;
+
+  for (level = 0; level < WDOG_WHEEL_LEVELS; level++)
+    {
+      pending = g_wdwheel.pending[level];
+      if (pending == 0)
+        {
+          continue;
+        }
+
+      /* Rotate the bitmap so that bit 0 is the first slot at or after the
+       * current position of this level.
+       */
+
+      start = g_wdwheel.curr >> WDOG_WHEEL_SHIFT(level);
+      if ((g_wdwheel.curr & (WDOG_WHEEL_SPAN(level) - 1)) != 0)
+        {
+          start++;
+        }
+
+      shift = start & WDOG_WHEEL_MASK;
+      if (shift != 0)
+        {
+          pending = (pending >> shift) |
+                    (pending << (WDOG_WHEEL_SLOTS - shift));
+        }
+
+      ticks = (start + ffs(pending) - 1) << WDOG_WHEEL_SHIFT(level);
+      if (!found || clock_compare(ticks, *next))
+        {
+          *next = ticks;
+          found = true;
+        }
+    }
+
+  return found;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_insert
+ *
+ * Description:
+ *   Add an armed watchdog to the timer wheel.  The expiration time must
+ *   already be stored in wdog->expired.
+ *
+ * Returned Value:
+ *   True if the next wheel event has changed and the interval timer must
+ *   be reassessed (tickless mode only).
+ *
+ * Assumptions:
+ *   Called with g_wdspinlock held.
+ *
+ ****************************************************************************/
+
+bool wd_wheel_insert(FAR struct wdog_s *wdog)
+{
+#ifdef CONFIG_SCHED_TICKLESS
+  clock_t before;
+  clock_t after;
+  bool valid;
+
+  valid = wd_wheel_next(&before);
+#endif
+
+  if (wd_wheel_empty())
+    {
+      clock_t now = clock_systime_ticks();
+
+      /* Nothing is pending, so all ticks up to now are trivially processed.
+       * Move the wheel forward to avoid cascading stale slots.
+       */
+
+      if (clock_compare(g_wdwheel.curr, now))
+        {
+          g_wdwheel.curr = now;
+        }
+    }
+
+  wd_wheel_add(wdog);
+
+#ifdef CONFIG_SCHED_TICKLESS
+  wd_wheel_next(&after);
+  return !valid || before != after;
+#else
+  return false;
+#endif
+}
+
+/****************************************************************************
+ * Name: wd_wheel_delete
+ *
+ * Description:
+ *   Remove an active watchdog from the timer wheel.
+ *
+ * Returned Value:
+ *   True if the next wheel event has changed and the interval timer must
+ *   be reassessed (tickless mode only).
+ *
+ * Assumptions:
+ *   Called with g_wdspinlock held.
+ *
+ ****************************************************************************/
+
+bool wd_wheel_delete(FAR struct wdog_s *wdog)
+{
+  FAR struct list_node *next = wdog->node.next;
+  unsigned int index;
+#ifdef CONFIG_SCHED_TICKLESS
+  clock_t before;
+  clock_t after;
+
+  wd_wheel_next(&before);
+#endif
+
+  /* If this is the only watchdog in its slot, then both neighbours are the
+   * slot head itself and the slot becomes empty.
+   */
+
+  if (next == wdog->node.prev)
+    {
+      index = next - &g_wdwheel.slots[0][0];
+      g_wdwheel.pending[index / WDOG_WHEEL_SLOTS] &=
+        ~(1u << (index % WDOG_WHEEL_SLOTS));
+    }
+
+  list_delete(&wdog->node);
+
+#ifdef CONFIG_SCHED_TICKLESS
+  return !wd_wheel_next(&after) || before != after;
+#else
+  return false;
+#endif
+}
+
+/****************************************************************************
+ * Name: wd_wheel_expired
+ *
+ * Description:
+ *   Advance the wheel up to 'ticks' and remove the next watchdog that has
+ *   expired.  Ticks without any work are skipped in a single step.
+ *
+ * Returned Value:
+ *   The expired watchdog or NULL if no more watchdogs expire at 'ticks'.
+ *
+ * Assumptions:
+ *   Called with g_wdspinlock held.
+ *
+ ****************************************************************************/
+
+FAR struct wdog_s *wd_wheel_expired(clock_t ticks)
+{
+  FAR struct list_node *slot;
+  FAR struct wdog_s *wdog;
+  unsigned int index;
+  clock_t next;
+
+  while (clock_compare(g_wdwheel.curr, ticks))
+    {
+      index = g_wdwheel.curr & WDOG_WHEEL_MASK;
+      if ((g_wdwheel.pending[0] & (1u << index)) != 0)
+        {
+          slot = &g_wdwheel.slots[0][index];
+          wdog = list_first_entry(slot, struct wdog_s, node);
+          list_delete(&wdog->node);
+
+          if (list_is_empty(slot))
+            {
+              g_wdwheel.pending[0] &= ~(1u << index);
+            }
+
+          return wdog;
+        }
+
+      /* Nothing left on this tick, jump to the next one with work */
+
+      if (!wd_wheel_next(&next) || !clock_compare(next, ticks))
+        {
+          g_wdwheel.curr = ticks + 1;
+          break;
+        }
+
+      g_wdwheel.curr = next;
+      wd_wheel_cascade(next);
+    }
+
+  return NULL;
+}
@@ -39,6 +39,11 @@
 #include <nuttx/list.h>
 #include <nuttx/spinlock_type.h>
 
+#ifdef CONFIG_WDOG_PERCPU
+#  include <nuttx/sched.h>
+#  include <nuttx/spinlock.h>
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -47,6 +52,38 @@
 
 #define list_node wdlist_node
 
+/* Access to the queue of active watchdogs of one CPU.  Without
+ * CONFIG_WDOG_PERCPU all CPUs share a single queue.
+ */
+
+#ifdef CONFIG_WDOG_PERCPU
+#  define WDOG_NQUEUES       CONFIG_SMP_NCPUS
+#  define wd_activelist(cpu) (&g_wdqueue[cpu].list)
+#  define wd_spinlock(cpu)   (&g_wdqueue[cpu].lock)
+#else
+#  define WDOG_NQUEUES       1
+#  define wd_activelist(cpu) ((void)(cpu), &g_wdactivelist)
+#  define wd_spinlock(cpu)   ((void)(cpu), &g_wdspinlock)
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+#ifdef CONFIG_WDOG_PERCPU
+/* The per-CPU watchdog queue.  Watchdogs are queued on the CPU that started
+ * them and expire on that CPU, so that timer heavy workloads on different
+ * CPUs do not contend for the same lock and cache lines.
+ */
+
+struct wd_queue_s
+{
+  spinlock_t             lock;   /* Protects the queue */
+  struct list_node       list;   /* Active watchdogs ordered by expiration */
+  struct smp_call_data_s call;   /* Request to process expired watchdogs */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -64,8 +101,53 @@ extern "C"
  * this linked list are removed and the function is called.
  */
 
+#if defined(CONFIG_WDOG_PERCPU)
+extern struct wd_queue_s g_wdqueue[CONFIG_SMP_NCPUS];
+#else
+#  ifndef CONFIG_WDOG_TIMER_WHEEL
 extern struct list_node g_wdactivelist;
+#  endif
 extern spinlock_t g_wdspinlock;
+#endif
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_WDOG_PERCPU
+/****************************************************************************
+ * Name: wd_lock_queue
+ *
+ * Description:
+ *   Lock the queue of the CPU that currently owns the watchdog.  The owner
+ *   may change while we spin for the lock, so retry until the lock taken
+ *   matches the owner.
+ *
+ * Returned Value:
+ *   The CPU index of the locked queue.
+ *
+ * Assumptions:
+ *   Local interrupts are disabled.
+ *
+ ****************************************************************************/
+
+static inline_function int wd_lock_queue(FAR struct wdog_s *wdog)
+{
+  int cpu;
+
+  for (; ; )
+    {
+      cpu = wdog->cpu;
+      spin_lock(wd_spinlock(cpu));
+      if (cpu == wdog->cpu)
+        {
+          return cpu;
+        }
+
+      spin_unlock(wd_spinlock(cpu));
+    }
+}
+#endif
 
 /****************************************************************************
  * Public Function Prototypes
@@ -125,6 +207,106 @@ void wd_timer(clock_t ticks);
 struct tcb_s;
 void wd_recover(FAR struct tcb_s *tcb);
 
+#ifdef CONFIG_WDOG_PERCPU
+
+/****************************************************************************
+ * Name: wd_initialize
+ *
+ * Description:
+ *   Initialize the per-CPU watchdog queues.  Called once during OS
+ *   initialization before any watchdog is started.
+ *
+ ****************************************************************************/
+
+void wd_initialize(void);
+
+/****************************************************************************
+ * Name: wd_smp_expiration
+ *
+ * Description:
+ *   SMP call handler that processes the expired watchdogs of the CPU it
+ *   runs on.  wd_timer() sends it to other CPUs whose queue has expired
+ *   watchdogs.
+ *
+ ****************************************************************************/
+
+int wd_smp_expiration(FAR void *arg);
+
+/****************************************************************************
+ * Name: wd_migrate
+ *
+ * Description:
+ *   Move an active watchdog to the queue of another CPU, e.g. after the
+ *   affinity of the thread that armed it has changed.  Nothing is done if
+ *   the watchdog is not active or is already queued on that CPU.
+ *
+ * Input Parameters:
+ *   wdog - Watchdog ID
+ *   cpu  - The CPU that should handle the expiration
+ *
+ ****************************************************************************/
+
+void wd_migrate(FAR struct wdog_s *wdog, int cpu);
+
+#endif /* CONFIG_WDOG_PERCPU */
+
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+
+/****************************************************************************
+ * Name: wd_wheel_insert, wd_wheel_delete
+ *
+ * Description:
+ *   Add or remove a watchdog from the hierarchical timer wheel.  The
+ *   expiration time must be set in wdog->expired before insertion.
+ *
+ * Returned Value:
+ *   True if the earliest wheel event has changed, i.e. the interval timer
+ *   needs to be reassessed.  Always false if CONFIG_SCHED_TICKLESS is not
+ *   defined.
+ *
+ * Assumptions:
+ *   Called with g_wdspinlock held.
+ *
+ ****************************************************************************/
+
+bool wd_wheel_insert(FAR struct wdog_s *wdog);
+bool wd_wheel_delete(FAR struct wdog_s *wdog);
+
+/****************************************************************************
+ * Name: wd_wheel_expired
+ *
+ * Description:
+ *   Advance the timer wheel up to 'ticks' and remove the next watchdog
+ *   that has expired.
+ *
+ * Returned Value:
+ *   The expired watchdog or NULL if none is left.
+ *
+ * Assumptions:
+ *   Called with g_wdspinlock held.
+ *
+ ****************************************************************************/
+
+FAR struct wdog_s *wd_wheel_expired(clock_t ticks);
+
+/****************************************************************************
+ * Name: wd_wheel_next
+ *
+ * Description:
+ *   Get the earliest tick at which the timer wheel must be serviced.
+ *
+ * Returned Value:
+ *   False if no watchdog is active.
+ *
+ * Assumptions:
+ *   Called with g_wdspinlock held.
+ *
+ ****************************************************************************/
+
+bool wd_wheel_next(FAR clock_t *next);
+
+#endif /* CONFIG_WDOG_TIMER_WHEEL */
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -74,6 +74,10 @@
 #  define CALL_WORKER(worker, arg) worker(arg)
 #endif
 
+#ifndef CONFIG_SCHED_WORKQUEUE_BATCH
+#  define CONFIG_SCHED_WORKQUEUE_BATCH 1
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -191,6 +195,7 @@ static int work_thread(int argc, FAR char *argv[])
   worker_t      worker;
   irqstate_t    flags;
   FAR void     *arg;
+  int           batch;
 
   /* Get the handle from argv */
 
@@ -223,8 +228,21 @@ static int work_thread(int argc, FAR char *argv[])
           work_dispatch(wqueue);
         }
 
-      if (!list_is_empty(&wqueue->expired))
+      /* Run up to CONFIG_SCHED_WORKQUEUE_BATCH works in a row before
+       * going back to the semaphore.  Each extra work takes the semaphore
+       * count posted for it, so that it costs no later wakeup.  If there
+       * is no count left, another worker was already woken up for the
+       * work and will run it in parallel.
+       */
+
+      for (batch = 0; batch < CONFIG_SCHED_WORKQUEUE_BATCH &&
+                      !list_is_empty(&wqueue->expired); batch++)
         {
+          if (batch > 0 && nxsem_trywait(&wqueue->sem) < 0)
+            {
+              break;
+            }
+
           work = list_first_entry(&wqueue->expired, struct work_s, node);
 
           list_delete(&work->node);